@@ -39,6 +39,8 @@ if (WITH_ASM AND NOT XMRIG_ARM AND NOT XMRIG_RISCV AND CMAKE_SIZEOF_VOID_P EQUAL
     set(XMRIG_ASM_SOURCES
         src/crypto/common/Assembly.h
         src/crypto/common/Assembly.cpp
+        src/crypto/cn/CnRCache.cpp
+        src/crypto/cn/CnRCache.h
         src/crypto/cn/r/CryptonightR_gen.cpp
         )
     set_property(TARGET ${XMRIG_ASM_LIBRARY} PROPERTY LINKER_LANGUAGE C)
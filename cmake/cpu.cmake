@@ -14,7 +14,7 @@ include(CheckCXXCompilerFlag)
 if (CMAKE_CXX_COMPILER_ID MATCHES MSVC)
     set(VAES_SUPPORTED ON)
 else()
-    CHECK_CXX_COMPILER_FLAG("-mavx2 -mvaes" VAES_SUPPORTED)
+    CHECK_CXX_COMPILER_FLAG("-mavx2 -mavx512f -mvaes" VAES_SUPPORTED)
 endif()
 
 if (NOT VAES_SUPPORTED)
@@ -23,9 +23,11 @@ if (WITH_RANDOMX)
         src/crypto/rx/RxCache.h
         src/crypto/rx/RxConfig.h
         src/crypto/rx/RxDataset.h
+        src/crypto/rx/RxDatasetFile.h
         src/crypto/rx/RxQueue.h
         src/crypto/rx/RxSeed.h
         src/crypto/rx/RxVm.h
+        src/crypto/rx/RxYespower.h
     )
 
     list(APPEND SOURCES_CRYPTO
@@ -52,17 +54,45 @@ if (WITH_RANDOMX)
         src/crypto/rx/RxCache.cpp
         src/crypto/rx/RxConfig.cpp
         src/crypto/rx/RxDataset.cpp
+        src/crypto/rx/RxDatasetFile.cpp
         src/crypto/rx/RxQueue.cpp
         src/crypto/rx/RxVm.cpp
+        src/crypto/rx/RxYespower.cpp
 
 		### Removed useless includes
 		src/crypto/randomx/panthera/sha256.c
 		src/crypto/randomx/panthera/KangarooTwelve.c
 		src/crypto/randomx/panthera/KeccakP-1600-reference.c
+		src/crypto/randomx/panthera/KeccakP-1600-opt64.c
 		src/crypto/randomx/panthera/KeccakSpongeWidth1600.c
 		src/crypto/randomx/panthera/yespower-opt.c
     )
 
+    if (CMAKE_SIZEOF_VOID_P EQUAL 8 AND NOT XMRIG_ARM AND NOT XMRIG_RISCV)
+        list(APPEND SOURCES_CRYPTO src/crypto/randomx/panthera/yespower-avx.c)
+
+        if (CMAKE_C_COMPILER_ID MATCHES MSVC)
+            set_source_files_properties(src/crypto/randomx/panthera/yespower-avx.c PROPERTIES COMPILE_FLAGS "/arch:AVX")
+        elseif (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
+            set_source_files_properties(src/crypto/randomx/panthera/yespower-avx.c PROPERTIES COMPILE_FLAGS "-Ofast -mavx")
+        endif()
+
+        if (WITH_AVX2)
+            list(APPEND SOURCES_CRYPTO
+                src/crypto/randomx/panthera/yespower-avx2.c
+                src/crypto/randomx/panthera/yespower-avx512vl.c
+            )
+
+            if (CMAKE_C_COMPILER_ID MATCHES MSVC)
+                set_source_files_properties(src/crypto/randomx/panthera/yespower-avx2.c PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+                set_source_files_properties(src/crypto/randomx/panthera/yespower-avx512vl.c PROPERTIES COMPILE_FLAGS "/arch:AVX512")
+            elseif (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
+                set_source_files_properties(src/crypto/randomx/panthera/yespower-avx2.c PROPERTIES COMPILE_FLAGS "-Ofast -mavx2")
+                set_source_files_properties(src/crypto/randomx/panthera/yespower-avx512vl.c PROPERTIES COMPILE_FLAGS "-Ofast -mavx512f -mavx512vl")
+            endif()
+        endif()
+    endif()
+
     if (WITH_ASM AND CMAKE_C_COMPILER_ID MATCHES MSVC)
         enable_language(ASM_MASM)
         list(APPEND SOURCES_CRYPTO
@@ -117,6 +147,12 @@ if (WITH_RANDOMX)
         if (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
             set_source_files_properties(src/crypto/randomx/blake2/avx2/blake2b_avx2.c PROPERTIES COMPILE_FLAGS "-Ofast -mavx2")
         endif()
+
+        list(APPEND SOURCES_CRYPTO src/crypto/randomx/panthera/KeccakP-1600-bmi2.c)
+
+        if (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
+            set_source_files_properties(src/crypto/randomx/panthera/KeccakP-1600-bmi2.c PROPERTIES COMPILE_FLAGS "-Ofast -mbmi -mbmi2")
+        endif()
     endif()
 
     if (CMAKE_CXX_COMPILER_ID MATCHES Clang)
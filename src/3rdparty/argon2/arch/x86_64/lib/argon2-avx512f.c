@@ -308,12 +308,22 @@ void xmrig_ar2_fill_segment_avx512f(const argon2_instance_t *instance, argon2_po
     }
 }
 
+#define ARGON2_MULTI_VEC            __m512i
+#define ARGON2_MULTI_VECS_IN_BLOCK  ARGON2_VECS_IN_BLOCK
+#include "argon2-template-multi.h"
+
+void xmrig_ar2_fill_segment_avx512f_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position)
+{
+    fill_segment_multi(instances, count, position);
+}
+
 extern int cpu_flags_has_avx512f(void);
 int xmrig_ar2_check_avx512f(void) { return cpu_flags_has_avx512f(); }
 
 #else
 
 void xmrig_ar2_fill_segment_avx512f(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_avx512f_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position) {}
 int xmrig_ar2_check_avx512f(void) { return 0; }
 
 #endif
@@ -105,12 +105,18 @@ void xmrig_ar2_fill_segment_sse2(const argon2_instance_t *instance, argon2_posit
     fill_segment_128(instance, position);
 }
 
+void xmrig_ar2_fill_segment_sse2_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position)
+{
+    fill_segment_multi(instances, count, position);
+}
+
 extern int cpu_flags_has_sse2(void);
 int xmrig_ar2_check_sse2(void) { return cpu_flags_has_sse2(); }
 
 #else
 
 void xmrig_ar2_fill_segment_sse2(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_sse2_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position) {}
 int xmrig_ar2_check_sse2(void) { return 0; }
 
 #endif
@@ -117,12 +117,18 @@ void xmrig_ar2_fill_segment_ssse3(const argon2_instance_t *instance, argon2_posi
     fill_segment_128(instance, position);
 }
 
+void xmrig_ar2_fill_segment_ssse3_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position)
+{
+    fill_segment_multi(instances, count, position);
+}
+
 extern int cpu_flags_has_ssse3(void);
 int xmrig_ar2_check_ssse3(void) { return cpu_flags_has_ssse3(); }
 
 #else
 
 void xmrig_ar2_fill_segment_ssse3(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_ssse3_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position) {}
 int xmrig_ar2_check_ssse3(void) { return 0; }
 
 #endif
@@ -165,3 +165,7 @@ static void fill_segment_128(const argon2_instance_t *instance,
         }
     }
 }
+
+#define ARGON2_MULTI_VEC            __m128i
+#define ARGON2_MULTI_VECS_IN_BLOCK  ARGON2_OWORDS_IN_BLOCK
+#include "argon2-template-multi.h"
@@ -0,0 +1,124 @@
+/*
+ * Interleaved segment filling for several independent Argon2 instances.
+ *
+ * Must be included after fill_block() and next_addresses() with ARGON2_MULTI_VEC (the state vector type)
+ * and ARGON2_MULTI_VECS_IN_BLOCK defined. All instances must have identical parameters.
+ *
+ * Every step first resolves the reference blocks of all instances and prefetches them, then compresses
+ * one block of each instance, so the reference block loads of one hash overlap the BLAKE2 rounds of the
+ * others.
+ */
+
+static void prefetch_block(const block *b)
+{
+    const char *p = (const char *)b->v;
+    unsigned int i;
+
+    for (i = 0; i < ARGON2_BLOCK_SIZE; i += 64) {
+        _mm_prefetch(p + i, _MM_HINT_T0);
+    }
+}
+
+static void fill_segment_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position)
+{
+    const argon2_instance_t *instance = instances[0];
+    block *ref_block[ARGON2_MULTI_MAX];
+    block address_block[ARGON2_MULTI_MAX], input_block[ARGON2_MULTI_MAX];
+    uint64_t pseudo_rand, ref_index, ref_lane;
+    uint32_t prev_offset, curr_offset;
+    uint32_t starting_index, i, j;
+    ARGON2_MULTI_VEC state[ARGON2_MULTI_MAX][ARGON2_MULTI_VECS_IN_BLOCK];
+    int data_independent_addressing, with_xor;
+
+    if (instance == NULL || count == 0 || count > ARGON2_MULTI_MAX) {
+        return;
+    }
+
+    data_independent_addressing = (instance->type == Argon2_i) ||
+            (instance->type == Argon2_id && (position.pass == 0) &&
+             (position.slice < ARGON2_SYNC_POINTS / 2));
+
+    /* version 1.2.1 and earlier: overwrite, not XOR */
+    with_xor = !(0 == position.pass || ARGON2_VERSION_10 == instance->version);
+
+    starting_index = 0;
+
+    if ((0 == position.pass) && (0 == position.slice)) {
+        starting_index = 2; /* we have already generated the first two blocks */
+    }
+
+    for (j = 0; j < count; ++j) {
+        if (data_independent_addressing) {
+            init_block_value(&input_block[j], 0);
+
+            input_block[j].v[0] = position.pass;
+            input_block[j].v[1] = position.lane;
+            input_block[j].v[2] = position.slice;
+            input_block[j].v[3] = instance->memory_blocks;
+            input_block[j].v[4] = instance->passes;
+            input_block[j].v[5] = instance->type;
+
+            /* Don't forget to generate the first block of addresses: */
+            if (starting_index == 2) {
+                next_addresses(&address_block[j], &input_block[j]);
+            }
+        }
+    }
+
+    /* Offset of the current block */
+    curr_offset = position.lane * instance->lane_length +
+                  position.slice * instance->segment_length + starting_index;
+
+    if (0 == curr_offset % instance->lane_length) {
+        /* Last block in this lane */
+        prev_offset = curr_offset + instance->lane_length - 1;
+    } else {
+        /* Previous block */
+        prev_offset = curr_offset - 1;
+    }
+
+    for (j = 0; j < count; ++j) {
+        memcpy(state[j], ((instances[j]->memory + prev_offset)->v), ARGON2_BLOCK_SIZE);
+    }
+
+    for (i = starting_index; i < instance->segment_length;
+         ++i, ++curr_offset, ++prev_offset) {
+        /*1.1 Rotating prev_offset if needed */
+        if (curr_offset % instance->lane_length == 1) {
+            prev_offset = curr_offset - 1;
+        }
+
+        position.index = i;
+
+        for (j = 0; j < count; ++j) {
+            /* 1.2.1 Taking pseudo-random value from the previous block */
+            if (data_independent_addressing) {
+                if (i % ARGON2_ADDRESSES_IN_BLOCK == 0) {
+                    next_addresses(&address_block[j], &input_block[j]);
+                }
+                pseudo_rand = address_block[j].v[i % ARGON2_ADDRESSES_IN_BLOCK];
+            } else {
+                pseudo_rand = instances[j]->memory[prev_offset].v[0];
+            }
+
+            /* 1.2.2 Computing the lane of the reference block */
+            ref_lane = ((pseudo_rand >> 32)) % instance->lanes;
+
+            if ((position.pass == 0) && (position.slice == 0)) {
+                /* Can not reference other lanes yet */
+                ref_lane = position.lane;
+            }
+
+            /* 1.2.3 Computing the number of possible reference block within the lane. */
+            ref_index = xmrig_ar2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF, ref_lane == position.lane);
+
+            ref_block[j] = instances[j]->memory + instance->lane_length * ref_lane + ref_index;
+            prefetch_block(ref_block[j]);
+        }
+
+        /* 2 Creating new blocks */
+        for (j = 0; j < count; ++j) {
+            fill_block(state[j], ref_block[j], instances[j]->memory + curr_offset, with_xor);
+        }
+    }
+}
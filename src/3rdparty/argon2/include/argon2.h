@@ -316,6 +316,25 @@ ARGON2_PUBLIC int argon2id_hash_raw_ex(const uint32_t t_cost,
                                        const size_t hashlen,
                                        void *memory);
 
+/* maximum number of hashes computed at once by argon2id_hash_raw_ex_multi: */
+#define ARGON2_MULTI_MAX 4
+
+/**
+ * Computes "count" independent Argon2id hashes with parallelism 1 and the
+ * same cost parameters, their memory fills are interleaved to hide memory
+ * latency. Entry i of every array belongs to hash i.
+ */
+ARGON2_PUBLIC int argon2id_hash_raw_ex_multi(const uint32_t t_cost,
+                                             const uint32_t m_cost,
+                                             const uint32_t count,
+                                             const void *const *pwd,
+                                             const size_t pwdlen,
+                                             const void *const *salt,
+                                             const size_t saltlen,
+                                             void *const *hash,
+                                             const size_t hashlen,
+                                             void *const *memory);
+
 /* generic function underlying the above ones */
 ARGON2_PUBLIC int argon2_hash(const uint32_t t_cost, const uint32_t m_cost,
                               const uint32_t parallelism, const void *pwd,
@@ -442,6 +461,13 @@ ARGON2_PUBLIC void argon2_select_impl();
 ARGON2_PUBLIC const char *argon2_get_impl_name();
 ARGON2_PUBLIC int argon2_select_impl_by_name(const char *name);
 
+/**
+ * Lists the implementations supported by the current CPU.
+ * @param names Receives up to max implementation names
+ * @return Number of names written
+ */
+ARGON2_PUBLIC size_t argon2_get_impl_names(const char **names, size_t max);
+
 /* signals support for passing preallocated memory: */
 #define ARGON2_PREALLOCATED_MEMORY
 
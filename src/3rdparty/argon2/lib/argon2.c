@@ -54,12 +54,11 @@ size_t argon2_memory_size(uint32_t m_cost, uint32_t parallelism) {
     return memory_blocks * ARGON2_BLOCK_SIZE;
 }
 
-int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
-                   size_t memory_size) {
+static int argon2_init_instance(argon2_instance_t *instance, argon2_context *context, argon2_type type,
+                                void *memory, size_t memory_size) {
     /* 1. Validate all inputs */
     int result = xmrig_ar2_validate_inputs(context);
     uint32_t memory_blocks, segment_length;
-    argon2_instance_t instance;
 
     if (ARGON2_OK != result) {
         return result;
@@ -79,26 +78,32 @@ int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
         return ARGON2_MEMORY_ALLOCATION_ERROR;
     }
 
-    instance.version = context->version;
-    instance.memory = (block *)memory;
-    instance.passes = context->t_cost;
-    instance.memory_blocks = memory_blocks;
-    instance.segment_length = segment_length;
-    instance.lane_length = segment_length * ARGON2_SYNC_POINTS;
-    instance.lanes = context->lanes;
-    instance.threads = context->threads;
-    instance.type = type;
-    instance.print_internals = !!(context->flags & ARGON2_FLAG_GENKAT);
-    instance.keep_memory = memory != NULL;
-
-    if (instance.threads > instance.lanes) {
-        instance.threads = instance.lanes;
+    instance->version = context->version;
+    instance->memory = (block *)memory;
+    instance->passes = context->t_cost;
+    instance->memory_blocks = memory_blocks;
+    instance->segment_length = segment_length;
+    instance->lane_length = segment_length * ARGON2_SYNC_POINTS;
+    instance->lanes = context->lanes;
+    instance->threads = context->threads;
+    instance->type = type;
+    instance->print_internals = !!(context->flags & ARGON2_FLAG_GENKAT);
+    instance->keep_memory = memory != NULL;
+
+    if (instance->threads > instance->lanes) {
+        instance->threads = instance->lanes;
     }
 
     /* 3. Initialization: Hashing inputs, allocating memory, filling first
      * blocks
      */
-    result = xmrig_ar2_initialize(&instance, context);
+    return xmrig_ar2_initialize(instance, context);
+}
+
+int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
+                   size_t memory_size) {
+    argon2_instance_t instance;
+    int result = argon2_init_instance(&instance, context, type, memory, memory_size);
 
     if (ARGON2_OK != result) {
         return result;
@@ -259,34 +264,79 @@ int argon2id_hash_raw(const uint32_t t_cost, const uint32_t m_cost,
                        ARGON2_VERSION_NUMBER);
 }
 
+static void argon2_init_context_ex(argon2_context *context, const uint32_t t_cost, const uint32_t m_cost,
+                                   const uint32_t parallelism, const void *pwd,
+                                   const size_t pwdlen, const void *salt,
+                                   const size_t saltlen, void *hash, const size_t hashlen) {
+    context->out = (uint8_t *)hash;
+    context->outlen = (uint32_t)hashlen;
+    context->pwd = CONST_CAST(uint8_t *)pwd;
+    context->pwdlen = (uint32_t)pwdlen;
+    context->salt = CONST_CAST(uint8_t *)salt;
+    context->saltlen = (uint32_t)saltlen;
+    context->secret = NULL;
+    context->secretlen = 0;
+    context->ad = NULL;
+    context->adlen = 0;
+    context->t_cost = t_cost;
+    context->m_cost = m_cost;
+    context->lanes = parallelism;
+    context->threads = parallelism;
+    context->allocate_cbk = NULL;
+    context->free_cbk = NULL;
+    context->flags = ARGON2_DEFAULT_FLAGS;
+    context->version = ARGON2_VERSION_NUMBER;
+}
+
 int argon2id_hash_raw_ex(const uint32_t t_cost, const uint32_t m_cost,
                          const uint32_t parallelism, const void *pwd,
                          const size_t pwdlen, const void *salt,
                          const size_t saltlen, void *hash, const size_t hashlen, void *memory) {
     argon2_context context;
 
-    context.out = (uint8_t *)hash;
-    context.outlen = (uint32_t)hashlen;
-    context.pwd = CONST_CAST(uint8_t *)pwd;
-    context.pwdlen = (uint32_t)pwdlen;
-    context.salt = CONST_CAST(uint8_t *)salt;
-    context.saltlen = (uint32_t)saltlen;
-    context.secret = NULL;
-    context.secretlen = 0;
-    context.ad = NULL;
-    context.adlen = 0;
-    context.t_cost = t_cost;
-    context.m_cost = m_cost;
-    context.lanes = parallelism;
-    context.threads = parallelism;
-    context.allocate_cbk = NULL;
-    context.free_cbk = NULL;
-    context.flags = ARGON2_DEFAULT_FLAGS;
-    context.version = ARGON2_VERSION_NUMBER;
+    argon2_init_context_ex(&context, t_cost, m_cost, parallelism, pwd, pwdlen, salt, saltlen, hash, hashlen);
 
     return argon2_ctx_mem(&context, Argon2_id, memory, m_cost * 1024);
 }
 
+int argon2id_hash_raw_ex_multi(const uint32_t t_cost, const uint32_t m_cost,
+                               const uint32_t count, const void *const *pwd,
+                               const size_t pwdlen, const void *const *salt,
+                               const size_t saltlen, void *const *hash,
+                               const size_t hashlen, void *const *memory) {
+    argon2_context context[ARGON2_MULTI_MAX];
+    argon2_instance_t instance[ARGON2_MULTI_MAX];
+    const argon2_instance_t *instances[ARGON2_MULTI_MAX];
+    uint32_t i;
+    int result;
+
+    if (count == 0 || count > ARGON2_MULTI_MAX) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    for (i = 0; i < count; ++i) {
+        argon2_init_context_ex(&context[i], t_cost, m_cost, 1, pwd[i], pwdlen, salt[i], saltlen, hash[i], hashlen);
+
+        result = argon2_init_instance(&instance[i], &context[i], Argon2_id, memory[i], m_cost * 1024);
+        if (ARGON2_OK != result) {
+            return result;
+        }
+
+        instances[i] = &instance[i];
+    }
+
+    result = xmrig_ar2_fill_memory_blocks_multi(instances, count);
+    if (ARGON2_OK != result) {
+        return result;
+    }
+
+    for (i = 0; i < count; ++i) {
+        xmrig_ar2_finalize(&context[i], &instance[i]);
+    }
+
+    return ARGON2_OK;
+}
+
 static int argon2_compare(const uint8_t *b1, const uint8_t *b2, size_t len) {
     size_t i;
     uint8_t d = 0U;
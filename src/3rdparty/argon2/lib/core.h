@@ -209,6 +209,14 @@ void xmrig_ar2_finalize(const argon2_context *context, argon2_instance_t *instan
  */
 void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t position);
 
+/*
+ * Fills the same segment of several instances with identical parameters
+ * @param instances Pointers to the instances
+ * @param count Number of instances, up to ARGON2_MULTI_MAX
+ * @param position Current position
+ */
+void xmrig_ar2_fill_segment_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position);
+
 /*
  * Function that fills the entire memory t_cost times based on the first two
  * blocks in each lane
@@ -217,4 +225,10 @@ void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t
  */
 int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance);
 
+/*
+ * Same as xmrig_ar2_fill_memory_blocks for several instances with identical
+ * parameters at once
+ */
+int xmrig_ar2_fill_memory_blocks_multi(const argon2_instance_t *const *instances, uint32_t count);
+
 #endif
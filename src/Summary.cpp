@@ -192,11 +192,12 @@ static void print_commands(Config *)
                                                                  MAGENTA_BG_BOLD("p") WHITE_BOLD("ause, ")
                                                                  MAGENTA_BG_BOLD("r") WHITE_BOLD("esume, ")
                                                                  WHITE_BOLD("re") MAGENTA_BG(WHITE_BOLD_S "s") WHITE_BOLD("ults, ")
-                                                                 MAGENTA_BG_BOLD("c") WHITE_BOLD("onnection")
+                                                                 MAGENTA_BG_BOLD("c") WHITE_BOLD("onnection, ")
+                                                                 MAGENTA_BG_BOLD("t") WHITE_BOLD("hread counters")
                    );
     }
     else {
-        Log::print(" * COMMANDS     'h' hashrate, 'p' pause, 'r' resume, 's' results, 'c' connection");
+        Log::print(" * COMMANDS     'h' hashrate, 'p' pause, 'r' resume, 's' results, 'c' connection, 't' thread counters");
     }
 }
 
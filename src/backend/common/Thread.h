@@ -23,6 +23,9 @@
 #include "backend/common/interfaces/IWorker.h"
 
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 
@@ -44,18 +47,18 @@ class Thread
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Thread)
 
-    inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_config(config), m_backend(backend) {}
+    inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_config(new T(config)), m_backend(backend) {}
 
 #   ifdef XMRIG_OS_APPLE
-    inline ~Thread() { pthread_join(m_thread, nullptr); delete m_worker; }
+    inline ~Thread() { exit(); pthread_join(m_thread, nullptr); delete m_worker; }
 
     inline void start(void *(*callback)(void *))
     {
-        if (m_config.affinity >= 0) {
+        if (m_config->affinity >= 0) {
             pthread_create_suspended_np(&m_thread, nullptr, callback, this);
 
             mach_port_t mach_thread              = pthread_mach_thread_np(m_thread);
-            thread_affinity_policy_data_t policy = { static_cast<integer_t>(m_config.affinity + 1) };
+            thread_affinity_policy_data_t policy = { static_cast<integer_t>(m_config->affinity + 1) };
 
             thread_policy_set(mach_thread, THREAD_AFFINITY_POLICY, reinterpret_cast<thread_policy_t>(&policy), THREAD_AFFINITY_POLICY_COUNT);
             thread_resume(mach_thread);
@@ -65,22 +68,83 @@ public:
         }
     }
 #   else
-    inline ~Thread() { m_thread.join(); delete m_worker; }
+    inline ~Thread() { exit(); m_thread.join(); delete m_worker; }
 
     inline void start(void *(*callback)(void *))    { m_thread = std::thread(callback, this); }
 #   endif
 
-    inline const T &config() const                  { return m_config; }
+    inline const T &config() const                  { return *m_config; }
     inline IBackend *backend() const                { return m_backend; }
     inline IWorker *worker() const                  { return m_worker; }
     inline size_t id() const                        { return m_id; }
     inline void setWorker(IWorker *worker)          { m_worker = worker; }
 
+    // Persistent threads: the thread callback runs a worker for every launch() and parks in between
+
+    // Called by the thread, returns false when the thread should exit
+    inline bool wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_state != IDLE; });
+
+        if (m_state == EXIT) {
+            return false;
+        }
+
+        m_state = RUNNING;
+
+        return true;
+    }
+
+    // Called by the thread when its worker has finished
+    inline void done()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state == RUNNING) {
+            m_state = IDLE;
+        }
+
+        m_cv.notify_all();
+    }
+
+    inline void launch(const T &config)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_config.reset(new T(config));
+        m_state = LAUNCH;
+
+        m_cv.notify_all();
+    }
+
+    inline void waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_state == IDLE || m_state == EXIT; });
+    }
+
 private:
+    enum State {
+        IDLE,
+        LAUNCH,
+        RUNNING,
+        EXIT
+    };
+
+    inline void exit()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_state = EXIT;
+
+        m_cv.notify_all();
+    }
+
     const size_t m_id    = 0;
-    const T m_config;
+    std::unique_ptr<const T> m_config;
     IBackend *m_backend;
     IWorker *m_worker       = nullptr;
+    State m_state           = LAUNCH;
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
 
     #ifdef XMRIG_OS_APPLE
     pthread_t m_thread{};
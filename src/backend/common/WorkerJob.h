@@ -48,7 +48,7 @@ public:
     inline uint8_t index() const            { return m_index; }
 
 
-    inline void add(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+    inline void add(const Job &job, uint32_t reserveCount, Nonce::Backend backend, uint32_t node = Nonce::kNoNode)
     {
         m_sequence = Nonce::sequence(backend);
 
@@ -61,22 +61,25 @@ public:
             return;
         }
 
-        save(job, reserveCount, backend);
+        save(job, reserveCount, backend, node);
     }
 
 
-    inline bool nextRound(uint32_t rounds, uint32_t roundSize)
+    // "rounds" is the size of the next reservation in rounds, it may change from one reservation to another
+    inline bool nextRound(uint32_t rounds, uint32_t roundSize, uint32_t node = Nonce::kNoNode)
     {
-        m_rounds[index()]++;
+        if (m_left[index()] <= roundSize) {
+            m_left[index()] = rounds * roundSize;
 
-        if ((m_rounds[index()] & (rounds - 1)) == 0) {
             for (size_t i = 0; i < N; ++i) {
-                if (!Nonce::next(index(), nonce(i), rounds * roundSize, nonceMask())) {
+                if (!Nonce::next(index(), nonce(i), rounds * roundSize, nonceMask(), node)) {
                     return false;
                 }
             }
         }
         else {
+            m_left[index()] -= roundSize;
+
             for (size_t i = 0; i < N; ++i) {
                 writeUnaligned(nonce(i), readUnaligned(nonce(i)) + roundSize);
             }
@@ -92,26 +95,26 @@ public:
 private:
     inline uint64_t nonceMask() const     { return m_nonce_mask[index()]; }
 
-    inline void save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+    inline void save(const Job &job, uint32_t reserveCount, Nonce::Backend backend, uint32_t node)
     {
         m_index           = job.index();
         const size_t size = job.size();
         m_jobs[index()]   = job;
-        m_rounds[index()] = 0;
+        m_left[index()]   = reserveCount;
         m_nonce_mask[index()] = job.nonceMask();
 
         m_jobs[index()].setBackend(backend);
 
         for (size_t i = 0; i < N; ++i) {
             memcpy(m_blobs[index()] + (i * size), job.blob(), size);
-            Nonce::next(index(), nonce(i), reserveCount, nonceMask());
+            Nonce::next(index(), nonce(i), reserveCount, nonceMask(), node);
         }
     }
 
 
     alignas(8) uint8_t m_blobs[2][Job::kMaxBlobSize * N]{};
     Job m_jobs[2];
-    uint32_t m_rounds[2] = { 0, 0 };
+    uint32_t m_left[2]   = { 0, 0 };    // nonces left in the current reservation
     uint64_t m_nonce_mask[2] = { 0, 0 };
     uint64_t m_sequence  = 0;
     uint8_t m_index      = 0;
@@ -126,14 +129,14 @@ inline uint32_t *xmrig::WorkerJob<1>::nonce(size_t)
 
 
 template<>
-inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
+inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize, uint32_t node)
 {
-    m_rounds[index()]++;
-
     uint32_t* n = nonce();
 
-    if ((m_rounds[index()] & (rounds - 1)) == 0) {
-        if (!Nonce::next(index(), n, rounds * roundSize, nonceMask())) {
+    if (m_left[index()] <= roundSize) {
+        m_left[index()] = rounds * roundSize;
+
+        if (!Nonce::next(index(), n, rounds * roundSize, nonceMask(), node)) {
             return false;
         }
         if (nonceSize() == sizeof(uint64_t)) {
@@ -141,6 +144,7 @@ inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
         }
     }
     else {
+        m_left[index()] -= roundSize;
         writeUnaligned(n, readUnaligned(n) + roundSize);
     }
 
@@ -149,17 +153,17 @@ inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
 
 
 template<>
-inline void xmrig::WorkerJob<1>::save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+inline void xmrig::WorkerJob<1>::save(const Job &job, uint32_t reserveCount, Nonce::Backend backend, uint32_t node)
 {
     m_index           = job.index();
     m_jobs[index()]   = job;
-    m_rounds[index()] = 0;
+    m_left[index()]   = reserveCount;
     m_nonce_mask[index()] = job.nonceMask();
 
     m_jobs[index()].setBackend(backend);
 
     memcpy(blob(), job.blob(), job.size());
-    Nonce::next(index(), nonce(), reserveCount, nonceMask());
+    Nonce::next(index(), nonce(), reserveCount, nonceMask(), node);
 }
 
 
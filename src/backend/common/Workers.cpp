@@ -57,6 +57,15 @@ public:
 };
 
 
+// CPU threads are persistent: they keep their thread, affinity and scratchpad across algorithm switches,
+// stop() parks them and the next start() launches new workers on them.
+template<class T>
+static inline constexpr bool isPersistent()                 { return false; }
+
+template<>
+inline constexpr bool isPersistent<CpuLaunchData>()         { return true; }
+
+
 } // namespace xmrig
 
 
@@ -71,6 +80,8 @@ xmrig::Workers<T>::Workers() :
 template<class T>
 xmrig::Workers<T>::~Workers()
 {
+    release();
+
     delete d_ptr;
 }
 
@@ -121,6 +132,17 @@ const xmrig::Hashrate *xmrig::Workers<T>::hashrate() const
 }
 
 
+template<class T>
+void xmrig::Workers<T>::release()
+{
+    for (Thread<T> *worker : m_workers) {
+        delete worker;
+    }
+
+    m_workers.clear();
+}
+
+
 template<class T>
 void xmrig::Workers<T>::setBackend(IBackend *backend)
 {
@@ -135,11 +157,17 @@ void xmrig::Workers<T>::stop()
     Nonce::stop(T::backend());
 #   endif
 
-    for (Thread<T> *worker : m_workers) {
-        delete worker;
-    }
+    if (isPersistent<T>()) {
+        for (Thread<T> *handle : m_workers) {
+            handle->waitIdle();
 
-    m_workers.clear();
+            delete handle->worker();
+            handle->setWorker(nullptr);
+        }
+    }
+    else {
+        release();
+    }
 
 #   ifdef XMRIG_MINER_PROJECT
     Nonce::touch(T::backend());
@@ -172,6 +200,20 @@ xmrig::IWorker *xmrig::Workers<T>::create(Thread<T> *)
 }
 
 
+template<class T>
+void *xmrig::Workers<T>::onPersistent(void *arg)
+{
+    auto handle = static_cast<Thread<T>* >(arg);
+
+    while (handle->wait()) {
+        onReady(arg);
+        handle->done();
+    }
+
+    return nullptr;
+}
+
+
 template<class T>
 void *xmrig::Workers<T>::onReady(void *arg)
 {
@@ -201,8 +243,43 @@ void *xmrig::Workers<T>::onReady(void *arg)
 template<class T>
 void xmrig::Workers<T>::start(const std::vector<T> &data, bool /*sleep*/)
 {
-    for (const auto &item : data) {
-        m_workers.push_back(new Thread<T>(d_ptr->backend, m_workers.size(), item));
+    if (!isPersistent<T>()) {
+        for (const auto &item : data) {
+            m_workers.push_back(new Thread<T>(d_ptr->backend, m_workers.size(), item));
+        }
+
+        d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
+
+#       ifdef XMRIG_MINER_PROJECT
+        Nonce::touch(T::backend());
+#       endif
+
+        for (auto worker : m_workers) {
+            worker->start(Workers<T>::onReady);
+        }
+
+        return;
+    }
+
+    // Reuse a parked thread if it is pinned the same way, otherwise replace it
+    std::vector<bool> reuse(data.size(), false);
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        if (i < data.size() && m_workers[i]->config().affinity == data[i].affinity) {
+            reuse[i] = true;
+            continue;
+        }
+
+        delete m_workers[i];
+        m_workers[i] = nullptr;
+    }
+
+    m_workers.resize(data.size());
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (!reuse[i]) {
+            m_workers[i] = new Thread<T>(d_ptr->backend, i, data[i]);
+        }
     }
 
     d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
@@ -211,8 +288,13 @@ void xmrig::Workers<T>::start(const std::vector<T> &data, bool /*sleep*/)
     Nonce::touch(T::backend());
 #   endif
 
-    for (auto worker : m_workers) {
-        worker->start(Workers<T>::onReady);
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (reuse[i]) {
+            m_workers[i]->launch(data[i]);
+        }
+        else {
+            m_workers[i]->start(Workers<T>::onPersistent);
+        }
     }
 }
 
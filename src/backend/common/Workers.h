@@ -59,6 +59,7 @@ public:
     bool tick(uint64_t ticks);
     const Hashrate *hashrate() const;
     void jobEarlyNotification(const Job &job);
+    void release();
     void setBackend(IBackend *backend);
     void stop();
 
@@ -68,6 +69,7 @@ public:
 
 private:
     static IWorker *create(Thread<T> *handle);
+    static void *onPersistent(void *arg);
     static void *onReady(void *arg);
 
     void start(const std::vector<T> &data, bool sleep);
@@ -48,6 +48,9 @@ public:
     uint32_t remaining               = 0;
     uint32_t size;
     uint64_t doneTime                = 0;
+    uint64_t firstHashMin            = 0;   // time from the last job signal to the first hash of any thread, us
+    uint64_t firstHashMax            = 0;   // same for the slowest thread, us
+    uint32_t firstHashCount          = 0;
 };
 
 
@@ -127,6 +130,20 @@ void xmrig::BenchState::done()
 }
 
 
+void xmrig::BenchState::firstHash(uint64_t &first, uint64_t &last)
+{
+    first = 0;
+    last  = 0;
+
+    if (d_ptr) {
+        std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+        first = d_ptr->firstHashMin;
+        last  = d_ptr->firstHashMax;
+    }
+}
+
+
 void xmrig::BenchState::init(IBenchListener *listener, uint32_t size)
 {
     assert(d_ptr == nullptr);
@@ -135,6 +152,20 @@ void xmrig::BenchState::init(IBenchListener *listener, uint32_t size)
 }
 
 
+void xmrig::BenchState::setFirstHash(uint64_t latency)
+{
+    if (!d_ptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+    d_ptr->firstHashMin = d_ptr->firstHashCount ? std::min(d_ptr->firstHashMin, latency) : latency;
+    d_ptr->firstHashMax = std::max(d_ptr->firstHashMax, latency);
+    ++d_ptr->firstHashCount;
+}
+
+
 void xmrig::BenchState::setSize(uint32_t size)
 {
     assert(d_ptr != nullptr);
@@ -42,7 +42,9 @@ public:
     static uint64_t start(size_t threads, const IBackend *backend);
     static void destroy();
     static void done();
+    static void firstHash(uint64_t &first, uint64_t &last);
     static void init(IBenchListener *listener, uint32_t size);
+    static void setFirstHash(uint64_t latency);
     static void setSize(uint32_t size);
 
     inline static uint64_t data()           { return m_data; }
@@ -26,6 +26,7 @@
 #include "crypto/rx/RxConfig.h"
 
 
+#include <atomic>
 #include <cstdint>
 #include <utility>
 
@@ -34,6 +35,7 @@ namespace xmrig {
 
 
 class Job;
+class RxCache;
 class RxDataset;
 class RxSeed;
 
@@ -48,8 +50,12 @@ public:
 
     virtual bool isAllocated() const                                                                                            = 0;
     virtual HugePagesInfo hugePages() const                                                                                     = 0;
+    virtual RxCache *cache(const Job &job, uint32_t nodeId) const                                                               = 0;
     virtual RxDataset *dataset(const Job &job, uint32_t nodeId) const                                                           = 0;
     virtual void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) = 0;
+    virtual void save(const RxSeed &seed, const std::atomic<bool> &cancel)                                                      = 0;
+    virtual void prepare(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode,
+                         const std::atomic<bool> &cancel)                                                                       = 0;
 };
 
 
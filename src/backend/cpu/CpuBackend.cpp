@@ -26,6 +26,8 @@
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuCounters.h"
+#include "backend/cpu/CpuWorker.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/net/stratum/Job.h"
@@ -43,11 +45,21 @@
 #endif
 
 
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxYespower.h"
+#endif
+
+
 #ifdef XMRIG_ALGO_ARGON2
 #   include "crypto/argon2/Impl.h"
 #endif
 
 
+#ifdef XMRIG_ALGO_GHOSTRIDER
+#   include "crypto/ghostrider/ghostrider.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/Benchmark.h"
 #   include "backend/common/benchmark/BenchState.h"
@@ -162,6 +174,32 @@ public:
     }
 
 
+#   ifdef XMRIG_ALGO_ARGON2
+    void selectArgon2(bool benchmark)
+    {
+        if (!argon2::Impl::select(controller->config()->cpu().argon2Impl(), benchmark)) {
+            return;
+        }
+
+        if (argon2::Impl::isBenchmarked()) {
+            for (const auto &result : argon2::Impl::results()) {
+                LOG_INFO("%s " WHITE_BOLD("argon2") " benchmark " WHITE_BOLD("%-8s") " %.1f H/s", Tags::cpu(), result.name.data(), result.hashrate);
+            }
+        }
+
+        LOG_INFO("%s use " WHITE_BOLD("argon2") " implementation " CSI "1;%dm" "%s",
+                 Tags::cpu(),
+                 argon2::Impl::name() == "default" ? 33 : 32,
+                 argon2::Impl::name().data()
+                 );
+
+        if (argon2::Impl::isBenchmarked() && controller->config()->isAutoSave()) {
+            controller->config()->save();
+        }
+    }
+#   endif
+
+
     size_t ways() const
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -245,12 +283,26 @@ xmrig::CpuBackend::CpuBackend(Controller *controller) :
     d_ptr(new CpuBackendPrivate(controller))
 {
     d_ptr->workers.setBackend(this);
+
+#   ifdef XMRIG_ALGO_ARGON2
+    // The implementation benchmark takes a while, so it runs before the event loop starts instead of on the first job
+    const auto algorithms = Algorithm::all([this](const Algorithm &algo) {
+        return (algo.family() == Algorithm::ARGON2 || algo.family() == Algorithm::RANDOM_X) && isEnabled(algo);
+    });
+
+    if (isEnabled() && !algorithms.empty()) {
+        d_ptr->selectArgon2(true);
+    }
+#   endif
 }
 
 
 xmrig::CpuBackend::~CpuBackend()
 {
     delete d_ptr;
+
+    CpuMemory::release();
+    CpuCounters::release();
 }
 
 
@@ -268,6 +320,11 @@ bool xmrig::CpuBackend::isEnabled(const Algorithm &algorithm) const
 
 bool xmrig::CpuBackend::tick(uint64_t ticks)
 {
+    // Same window as the 10s hashrate the counters are divided by
+    if (ticks % 20 == 0) {
+        CpuCounters::sample();
+    }
+
     return d_ptr->workers.tick(ticks);
 }
 
@@ -295,13 +352,24 @@ void xmrig::CpuBackend::prepare(const Job &nextJob)
 #   ifdef XMRIG_ALGO_ARGON2
     const auto f = nextJob.algorithm().family();
     if ((f == Algorithm::ARGON2) || (f == Algorithm::RANDOM_X)) {
-        if (argon2::Impl::select(d_ptr->controller->config()->cpu().argon2Impl())) {
-            LOG_INFO("%s use " WHITE_BOLD("argon2") " implementation " CSI "1;%dm" "%s",
-                     Tags::cpu(),
-                     argon2::Impl::name() == "default" ? 33 : 32,
-                     argon2::Impl::name().data()
-                     );
-        }
+        // Only reached when no enabled algorithm needed argon2 at startup, no benchmark on the main loop
+        d_ptr->selectArgon2(false);
+    }
+#   endif
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (nextJob.algorithm() == Algorithm::RX_XLA && RxYespower::select()) {
+        LOG_INFO("%s use " WHITE_BOLD("yespower") " implementation " CSI "1;%dm" "%s",
+                 Tags::cpu(),
+                 RxYespower::name() == "SSE2" || RxYespower::name() == "default" ? 33 : 32,
+                 RxYespower::name().data()
+                 );
+    }
+#   endif
+
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    if (nextJob.algorithm() == Algorithm::GHOSTRIDER_RTM) {
+        ghostrider::set_live_tune(d_ptr->controller->config()->cpu().isGhostRiderLiveTune());
     }
 #   endif
 }
@@ -338,6 +406,52 @@ void xmrig::CpuBackend::printHashrate(bool details)
 }
 
 
+void xmrig::CpuBackend::execCommand(char command)
+{
+    if (command != 't' && command != 'T') {
+        return;
+    }
+
+    if (!d_ptr->controller->config()->cpu().isPerfCounters() || !hashrate()) {
+        LOG_INFO("%s " YELLOW("perf counters are disabled") BLACK_BOLD(" (\"perf-counters\": true in \"cpu\" section enables them)"), Tags::cpu());
+
+        return;
+    }
+
+    auto column = [](char *buf, size_t size, bool valid, double value, const char *format) {
+        if (valid) {
+            snprintf(buf, size, format, value);
+        }
+        else {
+            snprintf(buf, size, "n/a");
+        }
+
+        return buf;
+    };
+
+    char num[16 * 7] = { 0 };
+
+    Log::print(WHITE_BOLD_S "|    CPU # |  GHz |  IPC |   CYCLES/H |    INSTR/H |   L1D MISS/H |   LLC MISS/H |  DTLB MISS/H |");
+
+    for (size_t i = 0; i < d_ptr->threads.size(); ++i) {
+        const double h = hashrate()->calc(i, Hashrate::ShortInterval).second;
+        CpuCounters::Rates r;
+        const bool valid = CpuCounters::rates(i, r) && h > 0.0;
+
+        Log::print("| %8zu | %4s | %4s | %10s | %10s | %12s | %12s | %12s |",
+                   i,
+                   column(num,          16, valid && r.valid[CpuCounters::CYCLES] && r.valid[CpuCounters::TASK_CLOCK], r.value[CpuCounters::CYCLES] / r.value[CpuCounters::TASK_CLOCK], "%.2f"),
+                   column(num + 16,     16, valid && r.valid[CpuCounters::CYCLES] && r.valid[CpuCounters::INSTRUCTIONS], r.value[CpuCounters::INSTRUCTIONS] / r.value[CpuCounters::CYCLES], "%.2f"),
+                   column(num + 16 * 2, 16, valid && r.valid[CpuCounters::CYCLES], r.value[CpuCounters::CYCLES] / h, "%.0f"),
+                   column(num + 16 * 3, 16, valid && r.valid[CpuCounters::INSTRUCTIONS], r.value[CpuCounters::INSTRUCTIONS] / h, "%.0f"),
+                   column(num + 16 * 4, 16, valid && r.valid[CpuCounters::L1D_MISSES], r.value[CpuCounters::L1D_MISSES] / h, "%.1f"),
+                   column(num + 16 * 5, 16, valid && r.valid[CpuCounters::LLC_MISSES], r.value[CpuCounters::LLC_MISSES] / h, "%.1f"),
+                   column(num + 16 * 6, 16, valid && r.valid[CpuCounters::DTLB_MISSES], r.value[CpuCounters::DTLB_MISSES] / h, "%.1f")
+                   );
+    }
+}
+
+
 void xmrig::CpuBackend::printHealth()
 {
 }
@@ -346,11 +460,22 @@ void xmrig::CpuBackend::printHealth()
 void xmrig::CpuBackend::setJob(const Job &job)
 {
     if (!isEnabled()) {
-        return stop();
+        stop();
+
+        // Threads and scratchpads are kept only while the backend is enabled
+        d_ptr->workers.release();
+        CpuMemory::release();
+        CpuCounters::release();
+
+        return;
     }
 
     const auto &cpu = d_ptr->controller->config()->cpu();
 
+    if (!cpu.isPerfCounters()) {
+        CpuCounters::release();
+    }
+
     auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
     if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
         return;
@@ -436,9 +561,17 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("argon2-impl", argon2::Impl::name().toJSON(), allocator);
 #   endif
 
+#   ifdef XMRIG_ALGO_RANDOMX
+    out.AddMember("yespower-impl", RxYespower::name().toJSON(), allocator);
+#   endif
+
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
     out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    out.AddMember("ghostrider-helpers", ghostrider::helpers_to_json(doc), allocator);
+#   endif
+
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
     }
@@ -455,6 +588,10 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("av",          data.av(), allocator);
         thread.AddMember("hashrate",    hashrate()->toJSON(i, doc), allocator);
 
+        if (cpu.isPerfCounters()) {
+            thread.AddMember("counters", CpuCounters::toJSON(i, hashrate()->calc(i, Hashrate::ShortInterval).second, doc), allocator);
+        }
+
         i++;
         threads.PushBack(thread, allocator);
     }
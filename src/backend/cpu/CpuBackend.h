@@ -44,7 +44,7 @@ public:
     ~CpuBackend() override;
 
 protected:
-    inline void execCommand(char) override {}
+    void execCommand(char command) override;
 
     bool isEnabled() const override;
     bool isEnabled(const Algorithm &algorithm) const override;
@@ -22,6 +22,12 @@
 #include "backend/cpu/Cpu.h"
 #include "base/io/json/Json.h"
 
+
+#ifdef XMRIG_ALGO_ARGON2
+#   include "crypto/argon2/Impl.h"
+#endif
+
+
 #include <algorithm>
 
 
@@ -34,6 +40,8 @@ const char *CpuConfig::kHugePagesJit        = "huge-pages-jit";
 const char *CpuConfig::kHwAes               = "hw-aes";
 const char *CpuConfig::kMaxThreadsHint      = "max-threads-hint";
 const char *CpuConfig::kMemoryPool          = "memory-pool";
+const char *CpuConfig::kNumaNonces          = "numa-nonces";
+const char *CpuConfig::kPerfCounters        = "perf-counters";
 const char *CpuConfig::kPriority            = "priority";
 const char *CpuConfig::kYield               = "yield";
 
@@ -45,6 +53,10 @@ const char *CpuConfig::kAsm                 = "asm";
 const char *CpuConfig::kArgon2Impl          = "argon2-impl";
 #endif
 
+#ifdef XMRIG_ALGO_GHOSTRIDER
+const char *CpuConfig::kGhostRiderLiveTune  = "ghostrider-live-tune";
+#endif
+
 
 extern template class Threads<CpuThreads>;
 
@@ -71,6 +83,8 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kNumaNonces),   m_numaNonces, allocator);
+    obj.AddMember(StringRef(kPerfCounters), m_perfCounters, allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -81,7 +95,18 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
 #   ifdef XMRIG_ALGO_ARGON2
-    obj.AddMember(StringRef(kArgon2Impl), m_argon2Impl.toJSON(), allocator);
+    // Cache the benchmarked implementation, so the next start can skip the benchmark. The benchmark runs
+    // only if no implementation was set or the CPU does not support it.
+    if (argon2::Impl::isBenchmarked()) {
+        obj.AddMember(StringRef(kArgon2Impl), argon2::Impl::name().toJSON(doc), allocator);
+    }
+    else {
+        obj.AddMember(StringRef(kArgon2Impl), m_argon2Impl.toJSON(), allocator);
+    }
+#   endif
+
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    obj.AddMember(StringRef(kGhostRiderLiveTune), m_grLiveTune, allocator);
 #   endif
 
     m_threads.toJSON(obj, doc);
@@ -134,6 +159,8 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_hugePagesJit = Json::getBool(value, kHugePagesJit, m_hugePagesJit);
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
         m_yield        = Json::getBool(value, kYield, m_yield);
+        m_numaNonces   = Json::getBool(value, kNumaNonces, m_numaNonces);
+        m_perfCounters = Json::getBool(value, kPerfCounters, m_perfCounters);
 
         setAesMode(Json::getValue(value, kHwAes));
         setHugePages(Json::getValue(value, kHugePages));
@@ -148,6 +175,10 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_argon2Impl = Json::getString(value, kArgon2Impl);
 #       endif
 
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        m_grLiveTune = Json::getBool(value, kGhostRiderLiveTune, m_grLiveTune);
+#       endif
+
         m_threads.read(value);
 
         generate();
@@ -45,6 +45,8 @@ public:
     static const char *kHwAes;
     static const char *kMaxThreadsHint;
     static const char *kMemoryPool;
+    static const char *kNumaNonces;
+    static const char *kPerfCounters;
     static const char *kPriority;
     static const char *kYield;
 
@@ -56,6 +58,10 @@ public:
     static const char *kArgon2Impl;
 #   endif
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    static const char *kGhostRiderLiveTune;
+#   endif
+
     CpuConfig() = default;
 
     bool isHwAES() const;
@@ -66,7 +72,10 @@ public:
 
     inline bool isEnabled() const                       { return m_enabled; }
     inline bool isHugePages() const                     { return m_hugePageSize > 0; }
+    inline bool isGhostRiderLiveTune() const            { return m_grLiveTune; }
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
+    inline bool isNumaNonces() const                    { return m_numaNonces; }
+    inline bool isPerfCounters() const                  { return m_perfCounters; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
@@ -90,7 +99,10 @@ private:
     AesMode m_aes           = AES_AUTO;
     Assembly m_assembly;
     bool m_enabled          = true;
+    bool m_grLiveTune       = false;
     bool m_hugePagesJit     = false;
+    bool m_numaNonces       = true;
+    bool m_perfCounters     = false;
     bool m_shouldSave       = false;
     bool m_yield            = true;
     int m_memoryPool        = 0;
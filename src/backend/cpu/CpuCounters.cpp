@@ -0,0 +1,243 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/cpu/CpuCounters.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+
+
+#ifdef XMRIG_OS_LINUX
+#   include <linux/perf_event.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+#ifdef XMRIG_OS_LINUX
+struct CounterSlot
+{
+    int64_t tid             = -1;
+    int fd[CpuCounters::MAX];
+    uint64_t last[CpuCounters::MAX][3] = {};    // value, time enabled, time running
+    uint64_t ts             = 0;
+    CpuCounters::Rates rates;
+    bool sampled            = false;
+};
+
+
+static bool warned = false;
+static std::mutex mutex;
+static std::vector<CounterSlot *> slots;
+
+
+static int openEvent(uint32_t type, uint64_t config)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = type != PERF_TYPE_SOFTWARE;
+    attr.exclude_hv     = 1;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+
+static inline uint64_t cacheMiss(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+
+static void closeSlot(CounterSlot *slot)
+{
+    for (int &fd : slot->fd) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+#endif
+
+
+} // namespace xmrig
+
+
+bool xmrig::CpuCounters::rates(size_t id, Rates &rates)
+{
+#   ifdef XMRIG_OS_LINUX
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (id >= slots.size() || !slots[id] || std::none_of(slots[id]->rates.valid, slots[id]->rates.valid + MAX, [](bool valid) { return valid; })) {
+        return false;
+    }
+
+    rates = slots[id]->rates;
+
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+
+void xmrig::CpuCounters::open(size_t id)
+{
+#   ifdef XMRIG_OS_LINUX
+    const int64_t tid = syscall(SYS_gettid);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (slots.size() <= id) {
+        slots.resize(id + 1, nullptr);
+    }
+
+    if (!slots[id]) {
+        slots[id] = new CounterSlot();
+        std::fill_n(slots[id]->fd, static_cast<size_t>(MAX), -1);
+    }
+
+    CounterSlot *slot = slots[id];
+
+    // Counters follow the thread, a worker created again on the same thread keeps them
+    if (slot->tid == tid) {
+        return;
+    }
+
+    closeSlot(slot);
+
+    slot->tid               = tid;
+    slot->sampled           = false;
+    slot->rates             = Rates();
+    slot->fd[CYCLES]        = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    const int error         = errno;
+    slot->fd[INSTRUCTIONS]  = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    slot->fd[L1D_MISSES]    = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D));
+    slot->fd[LLC_MISSES]    = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL));
+    slot->fd[DTLB_MISSES]   = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB));
+    slot->fd[TASK_CLOCK]    = openEvent(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+
+    if (slot->fd[CYCLES] < 0 && !warned) {
+        warned = true;
+
+        LOG_WARN("%s " YELLOW("perf counters unavailable: \"%s\""), Tags::cpu(), strerror(error));
+    }
+#   endif
+}
+
+
+void xmrig::CpuCounters::release()
+{
+#   ifdef XMRIG_OS_LINUX
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (CounterSlot *slot : slots) {
+        if (slot) {
+            closeSlot(slot);
+            delete slot;
+        }
+    }
+
+    slots.clear();
+    warned = false;
+#   endif
+}
+
+
+void xmrig::CpuCounters::sample()
+{
+#   ifdef XMRIG_OS_LINUX
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const uint64_t ts = Chrono::steadyMSecs();
+
+    for (CounterSlot *slot : slots) {
+        if (!slot) {
+            continue;
+        }
+
+        const double seconds = static_cast<double>(ts - slot->ts) / 1000.0;
+
+        for (uint32_t i = 0; i < MAX; ++i) {
+            uint64_t data[3] = {};
+            if (slot->fd[i] < 0 || read(slot->fd[i], data, sizeof(data)) != sizeof(data)) {
+                slot->rates.valid[i] = false;
+                continue;
+            }
+
+            // Counters multiplexed with others are scaled by the share of time they were actually running
+            const uint64_t running = data[2] - slot->last[i][2];
+            const double value     = running ? static_cast<double>(data[0] - slot->last[i][0]) * (data[1] - slot->last[i][1]) / running : 0.0;
+
+            slot->rates.valid[i] = slot->sampled && running && seconds > 0.0;
+            slot->rates.value[i] = slot->rates.valid[i] ? value / seconds : 0.0;
+
+            memcpy(slot->last[i], data, sizeof(data));
+        }
+
+        slot->ts      = ts;
+        slot->sampled = true;
+    }
+#   endif
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::CpuCounters::toJSON(size_t id, double hashrate, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Rates r;
+    if (!rates(id, r)) {
+        return Value(kNullType);
+    }
+
+    auto perHash = [&r, hashrate](Event event) {
+        return (r.valid[event] && hashrate > 0.0) ? Value(r.value[event] / hashrate) : Value(kNullType);
+    };
+
+    Value out(kObjectType);
+    out.AddMember("ghz",            r.valid[CYCLES] && r.valid[TASK_CLOCK] && r.value[TASK_CLOCK] > 0.0 ? Value(r.value[CYCLES] / r.value[TASK_CLOCK]) : Value(kNullType), allocator);
+    out.AddMember("ipc",            r.valid[CYCLES] && r.valid[INSTRUCTIONS] && r.value[CYCLES] > 0.0 ? Value(r.value[INSTRUCTIONS] / r.value[CYCLES]) : Value(kNullType), allocator);
+    out.AddMember("cycles",         perHash(CYCLES), allocator);
+    out.AddMember("instructions",   perHash(INSTRUCTIONS), allocator);
+    out.AddMember("l1d_misses",     perHash(L1D_MISSES), allocator);
+    out.AddMember("llc_misses",     perHash(LLC_MISSES), allocator);
+    out.AddMember("dtlb_misses",    perHash(DTLB_MISSES), allocator);
+
+    return out;
+}
+#endif
@@ -0,0 +1,71 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUCOUNTERS_H
+#define XMRIG_CPUCOUNTERS_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// Optional hardware performance counters of CPU mining threads (Linux perf_event_open only).
+//
+// Every mining thread opens the counters for itself, the main loop samples them every 10 seconds and values are
+// reported per hash using the 10 seconds hashrate of the thread. Events refused by the kernel (for example in a
+// container or with a strict perf_event_paranoid) are reported as unavailable, mining is never affected.
+class CpuCounters
+{
+public:
+    enum Event : uint32_t {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        DTLB_MISSES,
+        TASK_CLOCK,     // nanoseconds on CPU, used for the frequency
+        MAX
+    };
+
+    struct Rates
+    {
+        double value[MAX]   = {};   // per second
+        bool valid[MAX]     = {};
+    };
+
+    static bool rates(size_t id, Rates &rates);
+    static void open(size_t id);
+    static void release();
+    static void sample();
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(size_t id, double hashrate, rapidjson::Document &doc);
+#   endif
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_CPUCOUNTERS_H */
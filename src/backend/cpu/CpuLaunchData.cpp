@@ -32,17 +32,34 @@
 #include <algorithm>
 
 
+namespace xmrig {
+
+
+static uint32_t launchIntensity(const Algorithm &algorithm, const CpuThread &thread)
+{
+    const uint32_t intensity = std::max<uint32_t>(std::min<uint32_t>(thread.intensity(), algorithm.maxIntensity()), algorithm.minIntensity());
+
+    // CPU workers exist for 1-5 and 8 hashes at once, 6 and 7 are rounded down to 5
+    return (intensity > 5 && intensity < 8) ? 5 : intensity;
+}
+
+
+} // namespace xmrig
+
+
 xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads, const std::vector<int64_t>& affinities) :
     algorithm(algorithm),
     assembly(config.assembly()),
     hugePages(config.isHugePages()),
     hwAES(config.isHwAES()),
+    numaNonces(config.isNumaNonces()),
+    perfCounters(config.isPerfCounters()),
     yield(config.isYield()),
     priority(config.priority()),
     affinity(thread.affinity()),
     miner(miner),
     threads(threads),
-    intensity(std::max<uint32_t>(std::min<uint32_t>(thread.intensity(), algorithm.maxIntensity()), algorithm.minIntensity())),
+    intensity(launchIntensity(algorithm, thread)),
     affinities(affinities)
 {
 }
@@ -54,6 +71,8 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
             && assembly         == other.assembly
             && hugePages        == other.hugePages
             && hwAES            == other.hwAES
+            && numaNonces       == other.numaNonces
+            && perfCounters     == other.perfCounters
             && intensity        == other.intensity
             && priority         == other.priority
             && affinity         == other.affinity
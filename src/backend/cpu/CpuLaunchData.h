@@ -60,6 +60,8 @@ public:
     const Assembly assembly;
     const bool hugePages;
     const bool hwAES;
+    const bool numaNonces;
+    const bool perfCounters;
     const bool yield;
     const int priority;
     const int64_t affinity;
@@ -17,11 +17,13 @@
  */
 
 #include <cassert>
+#include <map>
 #include <thread>
 #include <mutex>
 
 
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuCounters.h"
 #include "backend/cpu/CpuWorker.h"
 #include "base/tools/Alignment.h"
 #include "base/tools/Chrono.h"
@@ -53,7 +55,26 @@
 
 namespace xmrig {
 
-static constexpr uint32_t kReserveCount = 32768;
+static constexpr uint32_t kReserveCount    = 32768;     // also the minimum, smaller reservations gain nothing
+static constexpr uint32_t kReserveMax      = 1U << 22;
+static constexpr uint64_t kReserveInterval = 1000;      // target time between two reservations, ms
+
+
+struct CpuMemorySlot
+{
+    VirtualMemory *memory   = nullptr;
+    bool hugePages          = false;
+    uint32_t node           = 0;
+};
+
+
+static std::mutex memoryMutex;
+static std::vector<CpuMemorySlot> memorySlots;
+
+
+// Self-test results by algorithm, hash count, AV and assembly, the tests run once per process
+static std::mutex selfTestMutex;
+static std::map<uint64_t, bool> selfTestResults;
 
 
 #ifdef XMRIG_ALGO_CN_HEAVY
@@ -64,6 +85,45 @@ VirtualMemory* cn_heavyZen3Memory = nullptr;
 } // namespace xmrig
 
 
+xmrig::VirtualMemory *xmrig::CpuMemory::get(size_t id, size_t size, bool hugePages, uint32_t node)
+{
+    std::lock_guard<std::mutex> lock(memoryMutex);
+
+    if (memorySlots.size() <= id) {
+        memorySlots.resize(id + 1);
+    }
+
+    CpuMemorySlot &slot = memorySlots[id];
+    if (slot.memory && slot.hugePages == hugePages && slot.node == node) {
+        if (slot.memory->size() >= size) {
+            return slot.memory;
+        }
+
+        size = std::max(size, slot.memory->size());
+    }
+
+    delete slot.memory;
+
+    slot.memory    = new VirtualMemory(size, hugePages, false, true, node, VirtualMemory::kDefaultHugePageSize);
+    slot.hugePages = hugePages;
+    slot.node      = node;
+
+    return slot.memory;
+}
+
+
+void xmrig::CpuMemory::release()
+{
+    std::lock_guard<std::mutex> lock(memoryMutex);
+
+    for (CpuMemorySlot &slot : memorySlots) {
+        delete slot.memory;
+    }
+
+    memorySlots.clear();
+}
+
+
 
 template<size_t N>
 xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
@@ -73,10 +133,16 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_hwAES(data.hwAES),
     m_yield(data.yield),
     m_av(data.av()),
+    m_nonceNode(data.numaNonces && Cpu::info()->nodes() > 1 ? node() : Nonce::kNoNode),
     m_miner(data.miner),
     m_threads(data.threads),
-    m_ctx()
+    m_ctx(),
+    m_reserveCount(kReserveCount)
 {
+    if (data.perfCounters) {
+        CpuCounters::open(id);
+    }
+
 #   ifdef XMRIG_ALGO_CN_HEAVY
     // cn-heavy optimization for Zen3 CPUs
     const auto arch = Cpu::info()->arch();
@@ -95,11 +161,29 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     else
 #   endif
     {
-        m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, false, true, node(), VirtualMemory::kDefaultHugePageSize);
+        size_t size = m_algorithm.l3() * N;
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        // Panthera's yespower scratch lives right after the RandomX scratchpad, so it shares its huge pages and NUMA node
+        const size_t yespowerSize = m_algorithm == Algorithm::RX_XLA ? VirtualMemory::align(randomx_yespower_size(), 64) : 0;
+        size += yespowerSize;
+#       endif
+
+        m_memory = CpuMemory::get(id, size, data.hugePages, node());
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        if (yespowerSize && m_memory->scratchpad()) {
+            m_yespower = m_memory->scratchpad() + m_algorithm.l3() * N;
+        }
+#       endif
     }
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     m_ghHelper = ghostrider::create_helper_thread(affinity(), data.priority, data.affinities);
+
+    if (m_algorithm == Algorithm::FLEX_KCN) {
+        m_flexCtx = flex::create_ctx(m_hwAES);
+    }
 #   endif
 }
 
@@ -113,15 +197,9 @@ xmrig::CpuWorker<N>::~CpuWorker()
 
     CnCtx::release(m_ctx, N);
 
-#   ifdef XMRIG_ALGO_CN_HEAVY
-    if (m_memory != cn_heavyZen3Memory)
-#   endif
-    {
-        delete m_memory;
-    }
-
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     ghostrider::destroy_helper_thread(m_ghHelper);
+    flex::destroy_ctx(m_flexCtx);
 #   endif
 }
 
@@ -131,15 +209,33 @@ template<size_t N>
 void xmrig::CpuWorker<N>::allocateRandomX_VM()
 {
     RxDataset *dataset = Rx::dataset(m_job.currentJob(), node());
+    RxCache *cache     = nullptr;
 
     while (dataset == nullptr) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        // Hash in light mode on the already initialized cache while the dataset is still being built
+        if (id() < Rx::lightFallbackThreads() && (cache = Rx::cache(m_job.currentJob(), node())) != nullptr) {
+            allocateRandomX_LightVM(cache);
+            return;
+        }
 
+        // Miner::onDatasetReady() notifies through the job change, the generation is taken before the last check
+        const uint64_t generation = Nonce::generation();
         if (Nonce::sequence(Nonce::CPU) == 0) {
             return;
         }
 
         dataset = Rx::dataset(m_job.currentJob(), node());
+        if (dataset == nullptr) {
+            Nonce::wait(generation);
+        }
+    }
+
+    if (m_lightCache) {
+        // Dataset is ready, replace the light fallback VM with a full one
+        RxVm::destroy(m_vm);
+        m_vm = nullptr;
+
+        m_lightCache = nullptr;
     }
 
     if (!m_vm) {
@@ -147,11 +243,39 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
         uint8_t* scratchpad = m_memory->isHugePages() ? m_memory->scratchpad() : dataset->tryAllocateScrathpad();
         m_vm = RxVm::create(dataset, scratchpad ? scratchpad : m_memory->scratchpad(), !m_hwAES, m_assembly, node());
     }
-    else if (!dataset->get() && (m_job.currentJob().seed() != m_seed)) {
+    else if (dataset->get()) {
+        if (dataset != m_dataset) {
+            // Switch to another resident dataset
+            randomx_vm_set_dataset(m_vm, dataset->get());
+        }
+    }
+    else if ((dataset != m_dataset) || (m_job.currentJob().seed() != m_seed)) {
         // Update RandomX light VM with the new seed
         randomx_vm_set_cache(m_vm, dataset->cache()->get());
     }
-    m_seed = m_job.currentJob().seed();
+    m_dataset = dataset;
+    m_seed    = m_job.currentJob().seed();
+}
+
+
+template<size_t N>
+void xmrig::CpuWorker<N>::allocateRandomX_LightVM(RxCache *cache)
+{
+    if (m_vm && cache != m_lightCache) {
+        RxVm::destroy(m_vm);
+        m_vm = nullptr;
+    }
+
+    if (!m_vm) {
+        m_vm = RxVm::create(cache, m_memory->scratchpad(), !m_hwAES, m_assembly, node());
+    }
+    else if (m_job.currentJob().seed() != m_seed) {
+        randomx_vm_set_cache(m_vm, cache->get());
+    }
+
+    m_lightCache = cache;
+    m_dataset    = nullptr;
+    m_seed       = m_job.currentJob().seed();
 }
 #endif
 
@@ -167,13 +291,38 @@ bool xmrig::CpuWorker<N>::selfTest()
 
     allocateCnCtx();
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    if (m_algorithm == Algorithm::FLEX_KCN && !m_flexCtx) {
+        return false;
+    }
+#   endif
+
+    const uint64_t key = (static_cast<uint64_t>(m_algorithm.id()) << 32) | (N << 16) | (static_cast<uint64_t>(m_av) << 8) | static_cast<uint64_t>(m_assembly.id());
+
+    std::lock_guard<std::mutex> lock(selfTestMutex);
+
+    const auto it = selfTestResults.find(key);
+    if (it != selfTestResults.end()) {
+        return it->second;
+    }
+
+    const bool result = runSelfTest();
+    selfTestResults.emplace(key, result);
+
+    return result;
+}
+
+
+template<size_t N>
+bool xmrig::CpuWorker<N>::runSelfTest()
+{
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if (m_algorithm.family() == Algorithm::GHOSTRIDER) {
         switch (m_algorithm.id()) {
             case Algorithm::GHOSTRIDER_RTM:
                 return (N == 8) && verify(Algorithm::GHOSTRIDER_RTM, test_output_gr);
             case Algorithm::FLEX_KCN:
-                return (N == 1) && verify(Algorithm::FLEX_KCN, test_output_flex);
+                return verify(Algorithm::FLEX_KCN, test_output_flex);
             default:;
         }
     }
@@ -259,10 +408,12 @@ void xmrig::CpuWorker<N>::start()
 {
     while (Nonce::sequence(Nonce::CPU) > 0) {
         if (Nonce::isPaused()) {
-            do {
-                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            uint64_t generation = Nonce::generation();
+
+            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0) {
+                Nonce::wait(generation);
+                generation = Nonce::generation();
             }
-            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0);
 
             if (Nonce::sequence(Nonce::CPU) == 0) {
                 break;
@@ -314,7 +465,7 @@ void xmrig::CpuWorker<N>::start()
                     if (job.hasMinerSignature()) {
                         job.generateMinerSignature(m_job.blob(), job.size(), miner_signature_ptr);
                     }
-                    randomx_calculate_hash_first(m_vm, tempHash, m_job.blob(), job.size(), job.algorithm());
+                    randomx_calculate_hash_first(m_vm, tempHash, m_job.blob(), job.size(), job.algorithm(), m_yespower);
                 }
 
                 if (!nextRound()) {
@@ -325,7 +476,7 @@ void xmrig::CpuWorker<N>::start()
                     memcpy(miner_signature_saved, miner_signature_ptr, sizeof(miner_signature_saved));
                     job.generateMinerSignature(m_job.blob(), job.size(), miner_signature_ptr);
                 }
-                randomx_calculate_hash_next(m_vm, tempHash, m_job.blob(), job.size(), m_hash, job.algorithm());
+                randomx_calculate_hash_next(m_vm, tempHash, m_job.blob(), job.size(), m_hash, job.algorithm(), m_yespower);
             }
             else
 #           endif
@@ -343,8 +494,8 @@ void xmrig::CpuWorker<N>::start()
                             }
                             break;
                         case Algorithm::FLEX_KCN:
-                            if (N == 1) {
-                                flex_hash(reinterpret_cast<const char*>(m_job.blob()), reinterpret_cast<char*>(m_hash), m_ctx);
+                            if (m_flexCtx) {
+                                flex::hash_multi<N>(m_job.blob(), job.size(), m_hash, m_ctx, m_flexCtx);
                             } else {
                                 valid = false;
                             }
@@ -382,6 +533,21 @@ void xmrig::CpuWorker<N>::start()
                     }
                 }
                 m_count += N;
+
+#               ifdef XMRIG_FEATURE_BENCHMARK
+                if (m_firstHash) {
+                    const uint64_t now = static_cast<uint64_t>(Chrono::highResolutionMSecs() * 1000.0);
+                    m_firstHash        = false;
+
+                    BenchState::setFirstHash(now > Nonce::signalTime() ? now - Nonce::signalTime() : 0);
+                }
+#               endif
+
+#               ifdef XMRIG_ALGO_RANDOMX
+                if (m_lightCache) {
+                    Rx::addLightHashes(N);
+                }
+#               endif
             }
 
             if (m_yield) {
@@ -399,13 +565,17 @@ void xmrig::CpuWorker<N>::start()
 template<size_t N>
 bool xmrig::CpuWorker<N>::nextRound()
 {
+    if ((m_count - m_reserveHashes) / N >= m_reserveCount) {
+        updateReserveCount();
+    }
+
 #   ifdef XMRIG_FEATURE_BENCHMARK
-    const uint32_t count = m_benchSize ? 1U : kReserveCount;
+    const uint32_t count = m_benchSize ? 1U : m_reserveCount;
 #   else
-    constexpr uint32_t count = kReserveCount;
+    const uint32_t count = m_reserveCount;
 #   endif
 
-    if (!m_job.nextRound(count, 1)) {
+    if (!m_job.nextRound(count, 1, m_nonceNode)) {
         JobResults::done(m_job.currentJob());
 
         return false;
@@ -415,6 +585,33 @@ bool xmrig::CpuWorker<N>::nextRound()
 }
 
 
+// Sizes the reservation from the hashrate measured over the previous one, so fast algorithms don't hit the shared counter
+// more often than once per kReserveInterval. Narrow nonce space (nicehash, extranonce) keeps the default size.
+template<size_t N>
+void xmrig::CpuWorker<N>::updateReserveCount()
+{
+    const uint64_t now    = Chrono::steadyMSecs();
+    const uint64_t hashes = (m_count - m_reserveHashes) / N;
+
+    if (m_reserveTs && now > m_reserveTs && m_job.currentJob().nonceMask() >= 0xFFFFFFFFULL) {
+        const uint64_t target = std::min<uint64_t>(hashes * kReserveInterval / (now - m_reserveTs), kReserveMax);
+
+        uint32_t count = kReserveCount;
+        while (count < target) {
+            count <<= 1;
+        }
+
+        m_reserveCount = count;
+    }
+    else {
+        m_reserveCount = kReserveCount;
+    }
+
+    m_reserveTs     = now;
+    m_reserveHashes = m_count;
+}
+
+
 template<size_t N>
 bool xmrig::CpuWorker<N>::verify(const Algorithm &algorithm, const uint8_t *referenceValue)
 {
@@ -455,8 +652,18 @@ bool xmrig::CpuWorker<N>::verify(const Algorithm &algorithm, const uint8_t *refe
           0x44, 0xf8, 0xbd, 0x55, 0x45, 0xc3, 0x16, 0x4a, 0x3a, 0x76, 0xda, 0x50, 0x39, 0x53, 0x28, 0xc9, 0x07, 0x56, 0x33, 0x77,
           0x5b, 0xc4, 0xc8, 0x79, 0x8f, 0xd6, 0x77, 0x2b, 0x70, 0x0d, 0x21, 0x5c, 0xf0, 0xff, 0x0f, 0x1e, 0x00, 0x00, 0x00, 0x00
         };
-        char hash[32] = {};
-        flex_hash(reinterpret_cast<const char*>(header), hash, m_ctx);
+        if (!m_flexCtx) {
+            return false;
+        }
+
+        uint8_t blob[N * 80];
+        for (size_t i = 0; i < N; ++i) {
+            memcpy(blob + i * 80, header, sizeof header);
+            blob[i * 80 + 76] = static_cast<uint8_t>(i);
+        }
+
+        uint8_t hash[N * 32] = {};
+        flex::hash_multi<N>(blob, 80, hash, m_ctx, m_flexCtx);
         return memcmp(referenceValue, hash, sizeof hash) == 0;
       }
       default:;
@@ -553,12 +760,20 @@ void xmrig::CpuWorker<N>::consumeJob()
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     m_benchSize          = job.benchSize();
-    const uint32_t count = m_benchSize ? 1U : kReserveCount;
+    m_firstHash          = m_benchSize > 0;
+#   endif
+
+    if (job.nonceMask() < 0xFFFFFFFFULL) {
+        m_reserveCount = kReserveCount;
+    }
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    const uint32_t count = m_benchSize ? 1U : m_reserveCount;
 #   else
-    constexpr uint32_t count = kReserveCount;
+    const uint32_t count = m_reserveCount;
 #   endif
 
-    m_job.add(job, count, Nonce::CPU);
+    m_job.add(job, count, Nonce::CPU, m_nonceNode);
 
 #   ifdef XMRIG_ALGO_RANDOMX
     if (m_job.currentJob().algorithm().family() == Algorithm::RANDOM_X) {
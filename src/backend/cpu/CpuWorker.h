@@ -35,14 +35,27 @@ class randomx_vm;
 namespace xmrig {
 
 
+class RxCache;
+class RxDataset;
 class RxVm;
 
 
 #ifdef XMRIG_ALGO_GHOSTRIDER
 namespace ghostrider { struct HelperThread; }
+namespace flex { struct FlexCtx; }
 #endif
 
 
+// Scratchpads of CPU workers, kept per thread for the next worker of the same thread. A scratchpad only
+// grows, so switching back and forth between algorithms does not free and re-fault huge pages.
+class CpuMemory
+{
+public:
+    static VirtualMemory *get(size_t id, size_t size, bool hugePages, uint32_t node);
+    static void release();
+};
+
+
 template<size_t N>
 class CpuWorker : public Worker
 {
@@ -75,13 +88,16 @@ private:
 
 #   ifdef XMRIG_ALGO_RANDOMX
     void allocateRandomX_VM();
+    void allocateRandomX_LightVM(RxCache *cache);
 #   endif
 
     bool nextRound();
+    bool runSelfTest();
     bool verify(const Algorithm &algorithm, const uint8_t *referenceValue);
     bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
     void allocateCnCtx();
     void consumeJob();
+    void updateReserveCount();
 
     alignas(8) uint8_t m_hash[N * 32]{ 0 };
     const Algorithm m_algorithm;
@@ -89,22 +105,31 @@ private:
     const bool m_hwAES;
     const bool m_yield;
     const CnHash::AlgoVariant m_av;
+    const uint32_t m_nonceNode;
     const Miner *m_miner;
     const size_t m_threads;
     cryptonight_ctx *m_ctx[N];
-    VirtualMemory *m_memory = nullptr;
+    uint32_t m_reserveCount;
+    uint64_t m_reserveHashes    = 0;
+    uint64_t m_reserveTs        = 0;
+    VirtualMemory *m_memory     = nullptr;
     WorkerJob<N> m_job;
 
 #   ifdef XMRIG_ALGO_RANDOMX
     randomx_vm *m_vm        = nullptr;
+    RxCache *m_lightCache   = nullptr;
+    RxDataset *m_dataset    = nullptr;
+    uint8_t *m_yespower     = nullptr;
     Buffer m_seed;
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     ghostrider::HelperThread* m_ghHelper = nullptr;
+    flex::FlexCtx* m_flexCtx = nullptr;
 #   endif
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
+    bool m_firstHash        = false;
     uint32_t m_benchSize    = 0;
 #   endif
 };
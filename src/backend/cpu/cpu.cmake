@@ -3,6 +3,7 @@ set(HEADERS_BACKEND_CPU
     src/backend/cpu/CpuBackend.h
     src/backend/cpu/CpuConfig_gen.h
     src/backend/cpu/CpuConfig.h
+    src/backend/cpu/CpuCounters.h
     src/backend/cpu/CpuLaunchData.cpp
     src/backend/cpu/CpuThread.h
     src/backend/cpu/CpuThreads.h
@@ -15,6 +16,7 @@ set(SOURCES_BACKEND_CPU
     src/backend/cpu/Cpu.cpp
     src/backend/cpu/CpuBackend.cpp
     src/backend/cpu/CpuConfig.cpp
+    src/backend/cpu/CpuCounters.cpp
     src/backend/cpu/CpuLaunchData.h
     src/backend/cpu/CpuThread.cpp
     src/backend/cpu/CpuThreads.cpp
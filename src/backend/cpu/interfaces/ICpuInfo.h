@@ -75,6 +75,7 @@ public:
         FLAG_AVX,
         FLAG_AVX2,
         FLAG_AVX512F,
+        FLAG_AVX512VL,
         FLAG_BMI2,
         FLAG_OSXSAVE,
         FLAG_PDPE1GB,
@@ -419,6 +419,10 @@ bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
         return false;
     }
 
+    if (job.algorithm().family() == Algorithm::RANDOM_X) {
+        job.setNextSeedHash(Json::getString(params, "next_seed_hash"));
+    }
+
     job.setSigKey(Json::getString(params, "sig_key"));
 
     m_job.setClientId(m_rpcId);
@@ -484,6 +484,7 @@ bool xmrig::DaemonClient::parseJob(const rapidjson::Value &params, int *code)
     }
 
     job.setSeedHash(Json::getString(params, "seed_hash"));
+    job.setNextSeedHash(Json::getString(params, "next_seed_hash"));
     job.setHeight(Json::getUint64(params, kHeight));
     job.setDiff(Json::getUint64(params, "difficulty"));
 
@@ -92,6 +92,20 @@ bool xmrig::Job::setBlob(const char *blob)
 }
 
 
+bool xmrig::Job::setNextSeedHash(const char *hash)
+{
+    m_nextSeed = Buffer();
+
+    if (!hash || (strlen(hash) != kMaxSeedSize * 2)) {
+        return false;
+    }
+
+    m_nextSeed = Cvt::fromHex(hash, kMaxSeedSize * 2);
+
+    return !m_nextSeed.empty();
+}
+
+
 bool xmrig::Job::setSeedHash(const char *hash)
 {
     if (!hash || (strlen(hash) != kMaxSeedSize * 2)) {
@@ -241,6 +255,7 @@ void xmrig::Job::copy(const Job &other)
     m_target     = other.m_target;
     m_index      = other.m_index;
     m_seed       = other.m_seed;
+    m_nextSeed   = other.m_nextSeed;
     m_extraNonce = other.m_extraNonce;
     m_poolWallet = other.m_poolWallet;
 
@@ -292,6 +307,7 @@ void xmrig::Job::move(Job &&other)
     m_target     = other.m_target;
     m_index      = other.m_index;
     m_seed       = std::move(other.m_seed);
+    m_nextSeed   = std::move(other.m_nextSeed);
     m_extraNonce = std::move(other.m_extraNonce);
     m_poolWallet = std::move(other.m_poolWallet);
 
@@ -59,6 +59,7 @@ public:
     bool isEqual(const Job &other) const;
     bool isEqualBlob(const Job &other) const;
     bool setBlob(const char *blob);
+    bool setNextSeedHash(const char *hash);
     bool setSeedHash(const char *hash);
     bool setTarget(const char *target);
     size_t nonceOffset() const;
@@ -69,6 +70,7 @@ public:
     inline bool isValid() const                         { return (m_size > 0 && m_diff > 0) || !m_poolWallet.isEmpty(); }
     inline bool setId(const char *id)                   { return (m_id = id); }
     inline const Algorithm &algorithm() const           { return m_algorithm; }
+    inline const Buffer &nextSeed() const               { return m_nextSeed; }
     inline const Buffer &seed() const                   { return m_seed; }
     inline const String &clientId() const               { return m_clientId; }
     inline const String &extraNonce() const             { return m_extraNonce; }
@@ -149,6 +151,7 @@ private:
 
     Algorithm m_algorithm;
     bool m_nicehash     = false;
+    Buffer m_nextSeed;
     Buffer m_seed;
     size_t m_size       = 0;
     String m_clientId;
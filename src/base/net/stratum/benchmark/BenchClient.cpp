@@ -49,7 +49,8 @@ xmrig::BenchClient::BenchClient(const std::shared_ptr<BenchConfig> &benchmark, I
     blob.back() = '\0';
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
-    if (m_benchmark->algorithm().family() == Algorithm::GHOSTRIDER) {
+    // Rotate the GhostRider core/CN selection, Flex derives it from the header hash
+    if (m_benchmark->algorithm() == Algorithm::GHOSTRIDER_RTM) {
         const uint32_t q = (benchmark->rotation() / 20) & 1;
         const uint32_t r = benchmark->rotation() % 20;
 
@@ -169,6 +170,14 @@ void xmrig::BenchClient::onBenchDone(uint64_t result, uint64_t diff, uint64_t ts
     const double dt = static_cast<int64_t>(ts - m_readyTime) / 1000.0;
     LOG_NOTICE("%s " WHITE_BOLD("benchmark finished in ") CYAN_BOLD("%.3f seconds (%.1f h/s)") WHITE_BOLD_S " hash sum = " CLEAR "%s%016" PRIX64 CLEAR, tag(), dt, BenchState::size() / dt, color, result);
 
+    uint64_t first = 0;
+    uint64_t last  = 0;
+    BenchState::firstHash(first, last);
+
+    if (last) {
+        LOG_NOTICE("%s " WHITE_BOLD("time to first hash ") CYAN_BOLD("%.3f ms") BLACK_BOLD(" (all threads %.3f ms)"), tag(), first / 1000.0, last / 1000.0);
+    }
+
     if (m_token.isEmpty()) {
         printExit();
     }
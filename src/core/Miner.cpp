@@ -59,11 +59,26 @@
 #   include "crypto/rx/Profiler.h"
 #   include "crypto/rx/Rx.h"
 #   include "crypto/rx/RxConfig.h"
+#   include "crypto/rx/RxYespower.h"
+#endif
+
+
+#ifdef XMRIG_ALGO_ARGON2
+#   include "crypto/argon2/Impl.h"
+#endif
+
+
+#ifdef XMRIG_ALGO_KAWPOW
+#   include "crypto/kawpow/KPCache.h"
 #endif
 
 
 #ifdef XMRIG_ALGO_GHOSTRIDER
+#   include "base/tools/Baton.h"
 #   include "crypto/ghostrider/ghostrider.h"
+
+
+#   include <uv.h>
 #endif
 
 
@@ -73,6 +88,21 @@ namespace xmrig {
 static std::mutex mutex;
 
 
+#ifdef XMRIG_ALGO_GHOSTRIDER
+class MinerPrivate;
+
+
+class GhostRiderRetuneBaton : public Baton<uv_work_t>
+{
+public:
+    inline explicit GhostRiderRetuneBaton(MinerPrivate *miner) : miner(miner) {}
+
+    bool tuned          = false;
+    MinerPrivate *miner = nullptr;
+};
+#endif
+
+
 class MinerPrivate
 {
 public:
@@ -86,6 +116,12 @@ public:
     {
         delete timer;
 
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        if (grRetune) {
+            grRetune->miner = nullptr;
+        }
+#       endif
+
         for (IBackend *backend : backends) {
             delete backend;
         }
@@ -130,7 +166,7 @@ public:
 
         Nonce::touch();
 
-        if (active && enabled) {
+        if (active && enabled && !isRetuning()) {
             Nonce::pause(false);
         }
 
@@ -150,7 +186,13 @@ public:
         reply.AddMember("version",      APP_VERSION, allocator);
         reply.AddMember("kind",         APP_KIND, allocator);
         reply.AddMember("ua",           Platform::userAgent().toJSON(), allocator);
-        reply.AddMember("cpu",          Cpu::toJSON(doc), allocator);
+
+        Value cpu = Cpu::toJSON(doc);
+#       ifdef XMRIG_ALGO_RANDOMX
+        cpu.AddMember("yespower-impl", RxYespower::name().toJSON(), allocator);
+#       endif
+
+        reply.AddMember("cpu",          cpu, allocator);
         reply.AddMember("donate_level", controller->config()->pools().donateLevel(), allocator);
         reply.AddMember("paused",       !enabled, allocator);
 
@@ -357,15 +399,97 @@ public:
 
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    inline bool initRX() const { return Rx::init(job, controller->config()->rx(), controller->config()->cpu()); }
+    inline bool initRX() const
+    {
+        const bool ready = Rx::init(job, controller->config()->rx(), controller->config()->cpu());
+        if (ready) {
+            prepareRX();
+        }
+
+        return ready;
+    }
+
+    inline void prepareRX() const { Rx::prepare(job, controller->config()->rx(), controller->config()->cpu()); }
 #   endif
 
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
-    inline void initGhostRider() const { ghostrider::benchmark(); }
+    inline void initGhostRider(bool force = false)
+    {
+        if (ghostrider::benchmark(force)) {
+            saveGhostRiderTune();
+        }
+    }
+
+
+    inline void saveGhostRiderTune()
+    {
+        grTuneVersion = ghostrider::tune_version();
+
+        if (controller->config()->isAutoSave()) {
+            controller->config()->save();
+        }
+    }
+
+
+    // The benchmark takes a while, it runs on the libuv thread pool so stratum and the API stay responsive,
+    // the result is saved back on the main loop.
+    void retuneGhostRider()
+    {
+        if (grRetune) {
+            return;
+        }
+
+        // Stop workers while benchmarking, they would distort the results
+        Nonce::pause(true);
+        Nonce::touch();
+
+        grRetune = new GhostRiderRetuneBaton(this);
+
+        uv_queue_work(uv_default_loop(), &grRetune->req,
+            [](uv_work_t *req) {
+                auto baton = static_cast<GhostRiderRetuneBaton*>(req->data);
+
+                baton->tuned = ghostrider::benchmark(true);
+            },
+            [](uv_work_t *req, int) {
+                auto baton = static_cast<GhostRiderRetuneBaton*>(req->data);
+
+                if (baton->miner) {
+                    baton->miner->onGhostRiderRetuned(baton->tuned);
+                }
+
+                delete baton;
+            }
+        );
+    }
+
+
+    inline void onGhostRiderRetuned(bool tuned)
+    {
+        grRetune = nullptr;
+
+        if (tuned) {
+            saveGhostRiderTune();
+        }
+
+        if (active && enabled) {
+            Nonce::pause(false);
+        }
+    }
 #   endif
 
 
+    inline bool isRetuning() const
+    {
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        return grRetune != nullptr;
+#       else
+        return false;
+#       endif
+    }
+
+
     Algorithm algorithm;
     Algorithms algorithms;
     bool active         = false;
@@ -382,6 +506,11 @@ public:
     Timer *timer        = nullptr;
     uint64_t ticks      = 0;
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    GhostRiderRetuneBaton *grRetune = nullptr;
+    uint32_t grTuneVersion          = 0;
+#   endif
+
     Taskbar m_taskbar;
 };
 
@@ -567,6 +696,12 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
     }
 #   endif
 
+#   ifdef XMRIG_ALGO_KAWPOW
+    if (job.algorithm().family() == Algorithm::KAWPOW) {
+        KPCache::prefetch(job.height());
+    }
+#   endif
+
     d_ptr->algorithm = job.algorithm();
 
     mutex.lock();
@@ -594,12 +729,16 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
     if (!ready) {
         d_ptr->reset = true;
     }
+
+    // Start mining with light VMs right away, workers switch to the dataset after onDatasetReady()
+    const bool light = !ready && job.algorithm().family() == Algorithm::RANDOM_X && Rx::lightFallbackThreads() > 0;
 #   else
     constexpr const bool ready = true;
+    constexpr const bool light = false;
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
-    if (job.algorithm().id() == Algorithm::GHOSTRIDER_RTM) {
+    if (job.algorithm().id() == Algorithm::GHOSTRIDER_RTM && !d_ptr->isRetuning()) {
         d_ptr->initGhostRider();
     }
 #   endif
@@ -609,9 +748,13 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
     d_ptr->active = true;
     d_ptr->m_taskbar.setActive(true);
 
-    if (ready) {
+    if (ready || light) {
         d_ptr->handleJobChange();
     }
+
+    if (light) {
+        d_ptr->reset = false;
+    }
 }
 
 
@@ -673,6 +816,13 @@ void xmrig::Miner::onTimer(const Timer *)
         d_ptr->printHashrate(false);
     }
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    // Save the tuning table updated by live re-calibration, not more often than every 10 minutes
+    if (d_ptr->ticks && (d_ptr->ticks % 1200) == 0 && ghostrider::tune_version() != d_ptr->grTuneVersion) {
+        d_ptr->saveGhostRiderTune();
+    }
+#   endif
+
     d_ptr->ticks++;
 
     auto autoPause = [this](bool &state, bool pause, const char *pauseMessage, const char *activeMessage)
@@ -715,6 +865,20 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 
             d_ptr->getBackends(request.reply(), request.doc());
         }
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        else if (request.url() == "/2/ghostrider") {
+            request.accept();
+
+            request.reply() = ghostrider::tune_status(request.doc());
+        }
+#       endif
+#       ifdef XMRIG_ALGO_ARGON2
+        else if (request.url() == "/2/argon2") {
+            request.accept();
+
+            request.reply() = argon2::Impl::toJSON(request.doc());
+        }
+#       endif
     }
     else if (request.type() == IApiRequest::REQ_JSON_RPC) {
         if (request.rpcMethod() == "pause") {
@@ -732,6 +896,13 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 
             stop();
         }
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        else if (request.rpcMethod() == "ghostrider_retune") {
+            request.accept();
+
+            d_ptr->retuneGhostRider();
+        }
+#       endif
     }
 
     for (IBackend *backend : d_ptr->backends) {
@@ -748,6 +919,7 @@ void xmrig::Miner::onDatasetReady()
         return;
     }
 
+    d_ptr->prepareRX();
     d_ptr->handleJobChange();
 }
 #endif
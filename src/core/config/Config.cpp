@@ -36,6 +36,11 @@
 #endif
 
 
+#ifdef XMRIG_ALGO_GHOSTRIDER
+#   include "crypto/ghostrider/ghostrider.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_OPENCL
 #   include "backend/opencl/OclConfig.h"
 #endif
@@ -72,6 +77,10 @@ const char *Config::kHealthPrintTime    = "health-print-time";
 const char *Config::kDMI                = "dmi";
 #endif
 
+#ifdef XMRIG_ALGO_GHOSTRIDER
+const char *Config::kGhostRiderTune     = "ghostrider-tune";
+#endif
+
 
 class ConfigPrivate
 {
@@ -249,6 +258,10 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
     m_benchmark.read(reader.getValue(kAlgoPerf));
 #   endif
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    ghostrider::tune_read(reader.getValue(kGhostRiderTune));
+#   endif
+
 #   ifdef XMRIG_FEATURE_DMI
     d_ptr->dmi = reader.getBool(kDMI, d_ptr->dmi);
 #   endif
@@ -321,6 +334,10 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember(StringRef(kAlgoPerf),                 m_benchmark.toJSON(doc), allocator);
 #   endif
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    doc.AddMember(StringRef(kGhostRiderTune),           ghostrider::tune_to_json(doc), allocator);
+#   endif
+
     doc.AddMember(StringRef(kPauseOnBattery),           isPauseOnBattery(), allocator);
     doc.AddMember(StringRef(kPauseOnActive),            (d_ptr->idleTime == 0U || d_ptr->idleTime == kIdleTime) ? Value(isPauseOnActive()) : Value(d_ptr->idleTime), allocator);
 }
@@ -66,6 +66,10 @@ public:
     static const char *kDMI;
 #   endif
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    static const char *kGhostRiderTune;
+#   endif
+
     Config();
     ~Config() override;
 
@@ -52,6 +52,13 @@ R"===(
         "rdmsr": true,
         "wrmsr": true,
         "cache_qos": false,
+        "max_datasets": 1,
+        "max_datasets_memory": 0,
+        "prepare_next_dataset": false,
+        "prepare_next_dataset_threads": 1,
+        "dataset_file_path": null,
+        "dataset_file_max_size": 0,
+        "light_fallback_threads": 0,
         "numa": true,
         "scratchpad_prefetch_mode": 1
     },
@@ -63,9 +70,12 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "numa-nonces": true,
+        "perf-counters": false,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
+        "ghostrider-live-tune": false,
         "cn/0": false,
         "cn-lite/0": false
     },
@@ -49,6 +49,34 @@ inline void single_hash(const uint8_t *__restrict__ input, size_t size, uint8_t
 }
 
 
+// Hashes N inputs with interleaved memory fills, every hash uses the scratchpad of its own context
+template<Algorithm::Id ALGO, size_t N>
+inline void multi_hash(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t)
+{
+    static_assert(N <= ARGON2_MULTI_MAX, "too many hashes");
+
+    const void *pwd[N];
+    void *hash[N];
+    void *memory[N];
+
+    for (size_t i = 0; i < N; ++i) {
+        pwd[i]    = input + i * size;
+        hash[i]   = output + i * 32;
+        memory[i] = ctx[i]->memory;
+    }
+
+    if (ALGO == Algorithm::AR2_CHUKWA) {
+        argon2id_hash_raw_ex_multi(3, 512, N, pwd, size, pwd, 16, hash, 32, memory);
+    }
+    else if (ALGO == Algorithm::AR2_CHUKWA_V2) {
+        argon2id_hash_raw_ex_multi(4, 1024, N, pwd, size, pwd, 16, hash, 32, memory);
+    }
+    else if (ALGO == Algorithm::AR2_WRKZ) {
+        argon2id_hash_raw_ex_multi(4, 256, N, pwd, size, pwd, 16, hash, 32, memory);
+    }
+}
+
+
 }} // namespace xmrig::argon2
 
 
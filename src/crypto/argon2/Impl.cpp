@@ -24,66 +24,141 @@
 
 
 #include "3rdparty/argon2.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/String.h"
 #include "crypto/argon2/Impl.h"
+#include "crypto/common/VirtualMemory.h"
 
 
+#include <cstring>
 
-namespace xmrig {
 
+#ifdef _MSC_VER
+#   define strcasecmp  _stricmp
+#endif
 
-static bool selected = false;
-static String implName;
 
+namespace xmrig {
 
-} // namespace xmrig
+
+static bool selected    = false;
+static bool benchmarked = false;
+static String implName;
+static std::vector<argon2::Impl::Result> results;
 
 
-extern "C" {
+static constexpr size_t kMaxImpls       = 16;
+static constexpr uint32_t kRounds       = 3;
+static constexpr double kRoundTime      = 25.0;    // milliseconds per implementation and round
 
+// Chukwa parameters, the cheapest Argon2 variant the miner runs
+static constexpr uint32_t kTimeCost     = 3;
+static constexpr uint32_t kMemoryCost   = 512;
 
-extern int xmrig_ar2_check_avx512f();
-extern int xmrig_ar2_check_avx2();
-extern int xmrig_ar2_check_ssse3();
-extern int xmrig_ar2_check_sse2();
 
+static bool isAvailable(const char *name, const char *const *names, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (strcasecmp(name, names[i]) == 0) {
+            return true;
+        }
+    }
 
+    return false;
 }
 
 
-bool xmrig::argon2::Impl::select(const String &nameHint, bool benchmark)
+// Runs chukwa hashes with every supported implementation and selects the fastest one.
+// The implementations take turns for several short rounds and the best round counts, so a frequency change
+// or a background task in the middle of the benchmark does not decide the result on its own.
+static void benchmark(const char *const *names, size_t count)
 {
-    if (!selected) {
-#       if defined(__x86_64__) || defined(_M_AMD64)
-        auto hint = nameHint;
+    results.clear();
+    results.resize(count);
 
-        if (hint.isEmpty() && !benchmark) {
-            if (xmrig_ar2_check_avx512f()) {
-                hint = "AVX-512F";
-            }
-            else if (xmrig_ar2_check_avx2()) {
-                hint = "AVX2";
-            }
-            else if (xmrig_ar2_check_ssse3()) {
-                hint = "SSSE3";
-            }
-            else if (xmrig_ar2_check_sse2()) {
-                hint = "SSE2";
+    auto memory = new VirtualMemory(argon2_memory_size(kMemoryCost, 1), false, false, false);
+    uint8_t input[76]{};
+    uint8_t output[32];
+
+    for (size_t i = 0; i < count; ++i) {
+        results[i].name = names[i];
+
+        argon2_select_impl_by_name(names[i]);
+        argon2id_hash_raw_ex(kTimeCost, kMemoryCost, 1, input, sizeof(input), input, 16, output, sizeof(output), memory->scratchpad());
+    }
+
+    for (uint32_t round = 0; round < kRounds; ++round) {
+        for (size_t i = 0; i < count; ++i) {
+            argon2_select_impl_by_name(names[i]);
+
+            const double start = Chrono::highResolutionMSecs();
+            double elapsed     = 0.0;
+            uint32_t hashes    = 0;
+
+            do {
+                memcpy(input + 39, &hashes, sizeof(hashes));
+                argon2id_hash_raw_ex(kTimeCost, kMemoryCost, 1, input, sizeof(input), input, 16, output, sizeof(output), memory->scratchpad());
+
+                ++hashes;
+                elapsed = Chrono::highResolutionMSecs() - start;
+            } while (elapsed < kRoundTime);
+
+            const double hashrate = hashes * 1000.0 / elapsed;
+            if (hashrate > results[i].hashrate) {
+                results[i].hashrate = hashrate;
             }
         }
+    }
 
-        if (!hint.isEmpty()) {
-            argon2_select_impl_by_name(hint);
+    delete memory;
+
+    size_t best = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (results[i].hashrate > results[best].hashrate) {
+            best = i;
         }
-#       endif
+    }
+
+    argon2_select_impl_by_name(names[best]);
+    benchmarked = true;
+}
+
+
+} // namespace xmrig
 
-        selected = true;
-        implName = argon2_get_impl_name();
 
-        return true;
+bool xmrig::argon2::Impl::select(const String &nameHint, bool benchmark)
+{
+    if (selected) {
+        return false;
     }
 
-    return false;
+    const char *names[kMaxImpls];
+    const size_t count = argon2_get_impl_names(names, kMaxImpls);
+
+    // A cached choice may come from a config copied from another machine, use it only if this CPU supports it
+    if (!nameHint.isEmpty() && isAvailable(nameHint, names, count)) {
+        argon2_select_impl_by_name(nameHint);
+    }
+    else if (benchmark && count > 1) {
+        xmrig::benchmark(names, count);
+    }
+    else if (count > 0) {
+        // Implementations are listed from the narrowest to the widest instruction set
+        argon2_select_impl_by_name(names[count - 1]);
+    }
+
+    selected = true;
+    implName = argon2_get_impl_name();
+
+    return true;
+}
+
+
+bool xmrig::argon2::Impl::isBenchmarked()
+{
+    return benchmarked;
 }
 
 
@@ -91,3 +166,31 @@ const xmrig::String &xmrig::argon2::Impl::name()
 {
     return implName;
 }
+
+
+const std::vector<xmrig::argon2::Impl::Result> &xmrig::argon2::Impl::results()
+{
+    return xmrig::results;
+}
+
+
+rapidjson::Value xmrig::argon2::Impl::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value benchmark(kArrayType);
+    for (const auto &result : xmrig::results) {
+        Value item(kObjectType);
+        item.AddMember("name",      result.name.toJSON(), allocator);
+        item.AddMember("hashrate",  result.hashrate, allocator);
+
+        benchmark.PushBack(item, allocator);
+    }
+
+    Value out(kObjectType);
+    out.AddMember("impl",       implName.toJSON(), allocator);
+    out.AddMember("benchmark",  benchmark, allocator);
+
+    return out;
+}
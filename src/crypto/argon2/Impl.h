@@ -26,10 +26,14 @@
 #define XMRIG_ARGON2_IMPL_H
 
 
-namespace xmrig {
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
+
 
+#include <vector>
 
-class String;
+
+namespace xmrig {
 
 
 namespace argon2 {
@@ -38,8 +42,19 @@ namespace argon2 {
 class Impl
 {
 public:
+    struct Result
+    {
+        String name;
+        double hashrate = 0.0;
+    };
+
+    // Selects "nameHint" if the CPU supports it, otherwise the fastest implementation measured by a short benchmark,
+    // or without "benchmark" the one for the widest instruction set the CPU supports
     static bool select(const String &nameHint, bool benchmark = false);
+    static bool isBenchmarked();
     static const String &name();
+    static const std::vector<Result> &results();
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
 };
 
 
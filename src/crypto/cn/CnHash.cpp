@@ -50,8 +50,27 @@
     } while (0)
 
 
+#define ADD_FN_OCTA(algo) do {                                                                       \
+        m_map[algo]->data[AV_OCTA][Assembly::NONE]        = cryptonight_octa_hash<algo,   false>;    \
+        m_map[algo]->data[AV_OCTA_SOFT][Assembly::NONE]   = cryptonight_octa_hash<algo,   true>;     \
+    } while (0)
+
+
+#ifdef XMRIG_ALGO_ARGON2
+#   define ADD_FN_ARGON2(algo) do {                                                                   \
+        m_map[algo]->data[AV_DOUBLE][Assembly::NONE]      = argon2::multi_hash<algo, 2>;             \
+        m_map[algo]->data[AV_DOUBLE_SOFT][Assembly::NONE] = argon2::multi_hash<algo, 2>;             \
+        m_map[algo]->data[AV_TRIPLE][Assembly::NONE]      = argon2::multi_hash<algo, 3>;             \
+        m_map[algo]->data[AV_TRIPLE_SOFT][Assembly::NONE] = argon2::multi_hash<algo, 3>;             \
+        m_map[algo]->data[AV_QUAD][Assembly::NONE]        = argon2::multi_hash<algo, 4>;             \
+        m_map[algo]->data[AV_QUAD_SOFT][Assembly::NONE]   = argon2::multi_hash<algo, 4>;             \
+    } while (0)
+#endif
+
+
 bool cn_sse41_enabled = false;
 bool cn_vaes_enabled = false;
+bool cn_vaes512_enabled = false;
 
 
 #ifdef XMRIG_FEATURE_ASM
@@ -366,14 +385,17 @@ xmrig::CnHash::CnHash()
     m_map[Algorithm::AR2_CHUKWA] = new cn_hash_fun_array{};
     m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE][Assembly::NONE]         = argon2::single_hash<Algorithm::AR2_CHUKWA>;
     m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE_SOFT][Assembly::NONE]    = argon2::single_hash<Algorithm::AR2_CHUKWA>;
+    ADD_FN_ARGON2(Algorithm::AR2_CHUKWA);
 
     m_map[Algorithm::AR2_CHUKWA_V2] = new cn_hash_fun_array{};
     m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
     m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE_SOFT][Assembly::NONE] = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
+    ADD_FN_ARGON2(Algorithm::AR2_CHUKWA_V2);
 
     m_map[Algorithm::AR2_WRKZ] = new cn_hash_fun_array{};
     m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE][Assembly::NONE]           = argon2::single_hash<Algorithm::AR2_WRKZ>;
     m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE_SOFT][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_WRKZ>;
+    ADD_FN_ARGON2(Algorithm::AR2_WRKZ);
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -383,6 +405,15 @@ xmrig::CnHash::CnHash()
     ADD_FN(Algorithm::CN_GR_3);
     ADD_FN(Algorithm::CN_GR_4);
     ADD_FN(Algorithm::CN_GR_5);
+
+#   if !defined(XMRIG_ARM) && !defined(XMRIG_RISCV)
+    ADD_FN_OCTA(Algorithm::CN_GR_0);
+    ADD_FN_OCTA(Algorithm::CN_GR_1);
+    ADD_FN_OCTA(Algorithm::CN_GR_2);
+    ADD_FN_OCTA(Algorithm::CN_GR_3);
+    ADD_FN_OCTA(Algorithm::CN_GR_4);
+    ADD_FN_OCTA(Algorithm::CN_GR_5);
+#   endif
 #   endif
 
 #   ifdef XMRIG_FEATURE_ASM
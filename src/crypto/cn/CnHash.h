@@ -55,6 +55,8 @@ public:
         AV_TRIPLE_SOFT, // --av=8  Triple hash mode (Software AES)
         AV_QUAD_SOFT,   // --av=9  Quard hash mode  (Software AES)
         AV_PENTA_SOFT,  // --av=10 Penta hash mode  (Software AES)
+        AV_OCTA,        // Octa hash mode, GhostRider only
+        AV_OCTA_SOFT,   // Octa hash mode  (Software AES), GhostRider only
         AV_MAX
     };
 
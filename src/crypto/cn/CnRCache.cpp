@@ -0,0 +1,147 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/cn/CnRCache.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+static constexpr size_t kCodeSize = 0x4000;
+
+
+struct CnRProgram
+{
+    void *code              = nullptr;
+    Algorithm::Id algo      = Algorithm::INVALID;
+    uint32_t variant        = 0;
+    Assembly::Id assembly   = Assembly::NONE;
+    uint64_t height         = 0;
+    uint64_t used           = 0;
+    uint32_t refs           = 0;    // number of contexts which may run this program
+};
+
+
+static std::mutex mutex;
+static std::vector<CnRProgram *> programs;
+static uint64_t counter = 0;
+
+
+static CnRProgram *find(Algorithm::Id algo, uint32_t variant, Assembly::Id assembly, uint64_t height)
+{
+    for (CnRProgram *program : programs) {
+        if (program->code && program->height == height && program->algo == algo && program->variant == variant && program->assembly == assembly) {
+            return program;
+        }
+    }
+
+    return nullptr;
+}
+
+
+static CnRProgram *generate(Algorithm::Id algo, uint32_t variant, Assembly::Id assembly, uint64_t height, CnRCache::Generator generator)
+{
+    // Reuse the least recently used program no context holds, new executable memory is needed only when all of them are held.
+    CnRProgram *program = nullptr;
+    for (CnRProgram *p : programs) {
+        if (p->refs == 0 && (!program || p->used < program->used)) {
+            program = p;
+        }
+    }
+
+    if (!program) {
+        void *code = VirtualMemory::allocateExecutableMemory(kCodeSize, false);
+        if (!code) {
+            return nullptr;
+        }
+
+        program       = new CnRProgram();
+        program->code = code;
+        programs.emplace_back(program);
+    }
+
+    VirtualMemory::protectRW(program->code, kCodeSize);
+    generator(height, assembly, program->code);
+    VirtualMemory::protectRX(program->code, kCodeSize);
+
+    program->algo     = algo;
+    program->variant  = variant;
+    program->assembly = assembly;
+    program->height   = height;
+    program->used     = ++counter;
+
+    return program;
+}
+
+
+static void unref(cn_mainloop_fun_ms_abi code)
+{
+    if (!code) {
+        return;
+    }
+
+    for (CnRProgram *program : programs) {
+        if (program->code == reinterpret_cast<void *>(code)) {
+            --program->refs;
+            return;
+        }
+    }
+}
+
+
+} // namespace xmrig
+
+
+cn_mainloop_fun_ms_abi xmrig::CnRCache::get(Algorithm::Id algo, Variant variant, Assembly::Id ASM, uint64_t height, Generator generator, cn_mainloop_fun_ms_abi prev)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    CnRProgram *program = find(algo, variant, ASM, height);
+    if (!program) {
+        program = generate(algo, variant, ASM, height, generator);
+        if (!program) {
+            unref(prev);
+
+            return nullptr;
+        }
+    }
+
+    program->used = ++counter;
+    ++program->refs;
+    unref(prev);
+
+    if (!find(algo, variant, ASM, height + 1)) {
+        generate(algo, variant, ASM, height + 1, generator);
+    }
+
+    return reinterpret_cast<cn_mainloop_fun_ms_abi>(program->code);
+}
+
+
+void xmrig::CnRCache::release(cn_mainloop_fun_ms_abi code)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    unref(code);
+}
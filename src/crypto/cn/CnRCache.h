@@ -0,0 +1,58 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CN_R_CACHE_H
+#define XMRIG_CN_R_CACHE_H
+
+
+#include "base/crypto/Algorithm.h"
+#include "crypto/cn/CryptoNight.h"
+#include "crypto/common/Assembly.h"
+
+
+namespace xmrig
+{
+
+
+// Process-wide cache of compiled CryptonightR main loops, keyed by height.
+//
+// All threads mining the same height share one read-only executable copy of the program, so it is
+// generated once per height instead of once per thread. Whenever a height is requested, the program for
+// the next height is generated as well, so a new block normally only costs a pointer swap.
+class CnRCache
+{
+public:
+    enum Variant : uint32_t {
+        SINGLE,
+        DOUBLE,
+        SOFT_AES
+    };
+
+    using Generator = void (*)(uint64_t height, Assembly::Id ASM, void *machine_code);
+
+    // Returns the main loop for "height", "prev" is the main loop the caller used until now (or nullptr).
+    // "prev" is released in any case, nullptr is returned if no executable memory could be allocated.
+    static cn_mainloop_fun_ms_abi get(Algorithm::Id algo, Variant variant, Assembly::Id ASM, uint64_t height, Generator generator, cn_mainloop_fun_ms_abi prev);
+    static void release(cn_mainloop_fun_ms_abi code);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CN_R_CACHE_H */
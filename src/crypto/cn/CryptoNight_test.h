@@ -409,12 +409,12 @@ const static uint8_t test_output_gpu[160] = {
 const static uint8_t argon2_chukwa_test_out[256] = {
     0xC1, 0x58, 0xA1, 0x05, 0xAE, 0x75, 0xC7, 0x56, 0x1C, 0xFD, 0x02, 0x90, 0x83, 0xA4, 0x7A, 0x87,
     0x65, 0x3D, 0x51, 0xF9, 0x14, 0x12, 0x8E, 0x21, 0xC1, 0x97, 0x1D, 0x8B, 0x10, 0xC4, 0x90, 0x34,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xC0, 0xDA, 0xD0, 0xEE, 0xB9, 0xC5, 0x2E, 0x92, 0xA1, 0xC3, 0xAA, 0x5B, 0x76, 0xA3, 0xCB, 0x90,
+    0xBD, 0x73, 0x76, 0xC2, 0x8D, 0xCE, 0x19, 0x1C, 0xEE, 0xB1, 0x09, 0x6E, 0x3A, 0x39, 0x0D, 0x2E,
+    0x36, 0x38, 0xC9, 0x94, 0x51, 0x30, 0xFD, 0xA8, 0x40, 0x65, 0xF8, 0xE2, 0xED, 0xBE, 0xD9, 0x13,
+    0x24, 0xC0, 0xE7, 0x7E, 0x50, 0xC1, 0xE1, 0x01, 0x5A, 0xAA, 0xDE, 0x83, 0xD3, 0xBD, 0x11, 0x49,
+    0x4A, 0x0C, 0x8E, 0xE0, 0xC2, 0xA6, 0xD6, 0xE2, 0x06, 0x2F, 0x40, 0x2F, 0xF6, 0xDF, 0xA4, 0x08,
+    0xC4, 0x85, 0xAA, 0xBD, 0xA8, 0x4E, 0x33, 0xD8, 0x89, 0x4A, 0xCA, 0x27, 0x4A, 0x56, 0x77, 0x11,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
@@ -423,12 +423,12 @@ const static uint8_t argon2_chukwa_test_out[256] = {
 const static uint8_t argon2_chukwa_v2_test_out[256] = {
     0x77, 0xCF, 0x69, 0x58, 0xB3, 0x53, 0x6E, 0x1F, 0x9F, 0x0D, 0x1E, 0xA1, 0x65, 0xF2, 0x28, 0x11,
     0xCA, 0x7B, 0xC4, 0x87, 0xEA, 0x9F, 0x52, 0x03, 0x0B, 0x50, 0x50, 0xC1, 0x7F, 0xCD, 0xD8, 0xF5,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x35, 0x78, 0xC1, 0x35, 0x26, 0x13, 0x66, 0xA7, 0xBA, 0xC4, 0x07, 0xB8, 0xC0, 0xFF, 0x50, 0xF3,
+    0xAD, 0x96, 0xF0, 0x96, 0xEC, 0x28, 0x13, 0xE9, 0x64, 0x4E, 0x6E, 0x77, 0xA4, 0x3F, 0x80, 0x3D,
+    0x19, 0x09, 0x6B, 0xD7, 0x83, 0x9D, 0x24, 0xD0, 0xF4, 0x4E, 0x81, 0x99, 0x6F, 0x03, 0x1A, 0xEE,
+    0x9D, 0xBA, 0xCE, 0x5D, 0xF9, 0xE4, 0x6A, 0xE8, 0x29, 0x68, 0x2A, 0xC1, 0x02, 0xE5, 0x5B, 0x6E,
+    0xA9, 0xB3, 0x43, 0x81, 0x33, 0xE8, 0x4D, 0x14, 0x56, 0x14, 0x5B, 0xE4, 0xEC, 0x39, 0x18, 0x61,
+    0x7E, 0x3E, 0xF2, 0x36, 0x81, 0x2D, 0x94, 0x30, 0x54, 0x58, 0xE5, 0x01, 0x7F, 0xD3, 0x99, 0x85,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
@@ -437,12 +437,12 @@ const static uint8_t argon2_chukwa_v2_test_out[256] = {
 const static uint8_t argon2_wrkz_test_out[256] = {
     0x35, 0xE0, 0x83, 0xD4, 0xB9, 0xC6, 0x4C, 0x2A, 0x68, 0x82, 0x0A, 0x43, 0x1F, 0x61, 0x31, 0x19,
     0x98, 0xA8, 0xCD, 0x18, 0x64, 0xDB, 0xA4, 0x07, 0x7E, 0x25, 0xB7, 0xF1, 0x21, 0xD5, 0x4B, 0xD1,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xB2, 0xFB, 0x90, 0x2B, 0xF4, 0x95, 0x99, 0x83, 0x9A, 0x61, 0xCA, 0x28, 0xA4, 0xF9, 0x81, 0xD5,
+    0x49, 0x68, 0x8F, 0xCD, 0x87, 0x59, 0xC4, 0x05, 0xE6, 0x79, 0xED, 0x9E, 0xF1, 0x36, 0xD1, 0xB9,
+    0x01, 0x97, 0xEB, 0xDB, 0x1A, 0x53, 0x6E, 0x8F, 0x21, 0xF5, 0x42, 0x74, 0x6C, 0xA9, 0x04, 0x31,
+    0x41, 0xBE, 0x16, 0x49, 0x97, 0x5A, 0x3B, 0x22, 0xC2, 0xAD, 0xED, 0xF8, 0x11, 0xCF, 0x50, 0x82,
+    0xAE, 0xF5, 0x6A, 0x69, 0x1F, 0x58, 0x3E, 0x3E, 0xEA, 0xD9, 0x4F, 0x6B, 0x13, 0xB4, 0x2B, 0x3D,
+    0x64, 0xBE, 0x0A, 0x9D, 0x72, 0x75, 0x64, 0x37, 0x87, 0x9A, 0x19, 0xCB, 0x6B, 0x75, 0x63, 0x0D,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
@@ -469,10 +469,24 @@ const static uint8_t test_output_gr[256] = {
     0xC4, 0xA7, 0xC7, 0x77, 0xAD, 0xF8, 0x09, 0x61, 0x16, 0xBB, 0xAA, 0x7E, 0xAB, 0xC3, 0x00, 0x25,
     0xBA, 0xA8, 0x97, 0xC7, 0x7D, 0x38, 0x46, 0x0E, 0x59, 0xAC, 0xCB, 0xAE, 0xFE, 0x3C, 0x6F, 0x01
 };
-// "Flex"
-const static uint8_t test_output_flex[32] = {
+// "Flex", 8 lanes with nonces 0..7
+const static uint8_t test_output_flex[256] = {
     0x2e, 0x4f, 0x85, 0x7a, 0xa8, 0x10, 0x08, 0xc4, 0xd1, 0xfe, 0x9a, 0xcd, 0x74, 0x89, 0xe8, 0x4d,
-    0x3b, 0xc5, 0x5b, 0x70, 0x54, 0xe6, 0xc0, 0x2b, 0x2c, 0x0e, 0x1b, 0x76, 0xcc, 0xa0, 0xda, 0x7b
+    0x3b, 0xc5, 0x5b, 0x70, 0x54, 0xe6, 0xc0, 0x2b, 0x2c, 0x0e, 0x1b, 0x76, 0xcc, 0xa0, 0xda, 0x7b,
+    0xa0, 0x1e, 0x15, 0x59, 0x14, 0x20, 0xbb, 0x9a, 0xad, 0x52, 0xc2, 0xa9, 0x36, 0x99, 0x8c, 0x1e,
+    0x98, 0xa6, 0x05, 0x68, 0x7e, 0xf6, 0xc0, 0x33, 0xae, 0xad, 0xd7, 0x5b, 0x87, 0xd0, 0xba, 0x06,
+    0xd7, 0xe7, 0x4a, 0xef, 0x61, 0x86, 0xbf, 0xe3, 0x9c, 0xcb, 0x90, 0x9c, 0xec, 0x94, 0x7e, 0x05,
+    0x29, 0x62, 0x9b, 0x64, 0x8d, 0x7c, 0x39, 0x8d, 0x03, 0xfd, 0x94, 0x71, 0xa4, 0x9b, 0xf1, 0x3d,
+    0x03, 0x69, 0x37, 0x71, 0x8b, 0xc3, 0xf8, 0x34, 0x30, 0x70, 0x83, 0x2c, 0x9c, 0xe2, 0x1c, 0x73,
+    0xb0, 0x3f, 0x2a, 0xfd, 0xaf, 0x83, 0x92, 0x13, 0xd4, 0x38, 0x68, 0xde, 0xda, 0xe1, 0x33, 0x9a,
+    0xf7, 0xda, 0xa4, 0x76, 0x9a, 0x01, 0x8a, 0x6f, 0x40, 0x55, 0x9b, 0x9d, 0xf1, 0xe5, 0xf3, 0x0c,
+    0xe8, 0x35, 0xd2, 0xb0, 0x3f, 0xe8, 0x9b, 0x6e, 0xd0, 0xce, 0x69, 0x4d, 0x79, 0xbe, 0x2c, 0xb0,
+    0x27, 0xe1, 0x4a, 0xc4, 0xeb, 0xb5, 0xca, 0xcd, 0x75, 0xb8, 0x4f, 0xb8, 0x36, 0xd4, 0xe2, 0x9b,
+    0xcc, 0x6d, 0x8a, 0x3b, 0xeb, 0x9b, 0xb1, 0xd8, 0x0d, 0xf0, 0x73, 0xb9, 0x4c, 0x47, 0x5f, 0x26,
+    0x8f, 0x3c, 0xf5, 0xaa, 0x6f, 0x4a, 0x23, 0xf5, 0xe0, 0x29, 0xa1, 0x68, 0xf0, 0xaa, 0x96, 0x79,
+    0x8c, 0xf8, 0x01, 0x9b, 0x78, 0x0e, 0x17, 0x14, 0x14, 0x7b, 0x26, 0x85, 0x7f, 0x56, 0x36, 0x45,
+    0xde, 0x76, 0x30, 0x58, 0xbe, 0x1e, 0xc4, 0xde, 0x09, 0x4c, 0x76, 0x43, 0x86, 0x6b, 0x83, 0x1f,
+    0xd1, 0xc0, 0x30, 0x17, 0x87, 0x72, 0xef, 0xf0, 0x9f, 0x84, 0x2d, 0x1c, 0xa0, 0xbb, 0x1d, 0x33
 };
 #endif
 
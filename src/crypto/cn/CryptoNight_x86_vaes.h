@@ -41,6 +41,10 @@ void cn_explode_scratchpad_vaes_double(cryptonight_ctx* ctx1, cryptonight_ctx* c
 void cn_implode_scratchpad_vaes(cryptonight_ctx* ctx, size_t memory, bool half_mem);
 void cn_implode_scratchpad_vaes_double(cryptonight_ctx* ctx1, cryptonight_ctx* ctx2, size_t memory, bool half_mem);
 
+// VAES-512, requires AVX-512F (cn_vaes512_enabled)
+void cn_explode_scratchpad_vaes_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem);
+void cn_implode_scratchpad_vaes_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem);
+
 
 } // xmrig
 
@@ -0,0 +1,296 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CryptoNight_x86_vaes.h"
+#include "CryptoNight_monero.h"
+#include "CryptoNight.h"
+
+
+#ifdef __GNUC__
+#   include <x86intrin.h>
+#else
+#   include <intrin.h>
+#endif
+
+
+// Four hashes are processed at once: every zmm register holds the same 16-byte block of all 4 scratchpads
+// and every round key register holds the round keys of all 4 hashes, so a single VAES instruction does
+// the AES round for 4 hashes.
+
+
+static FORCEINLINE __m128i sl_xor(__m128i tmp1)
+{
+    __m128i tmp4;
+    tmp4 = _mm_slli_si128(tmp1, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    tmp4 = _mm_slli_si128(tmp4, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    tmp4 = _mm_slli_si128(tmp4, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    return tmp1;
+}
+
+
+template<uint8_t rcon>
+static FORCEINLINE void aes_genkey_sub(__m128i* xout0, __m128i* xout2)
+{
+    __m128i xout1 = _mm_aeskeygenassist_si128(*xout2, rcon);
+    xout1 = _mm_shuffle_epi32(xout1, 0xFF); // see PSHUFD, set all elems to 4th elem
+    *xout0 = sl_xor(*xout0);
+    *xout0 = _mm_xor_si128(*xout0, xout1);
+    xout1 = _mm_aeskeygenassist_si128(*xout0, 0x00);
+    xout1 = _mm_shuffle_epi32(xout1, 0xAA); // see PSHUFD, set all elems to 3rd elem
+    *xout2 = sl_xor(*xout2);
+    *xout2 = _mm_xor_si128(*xout2, xout1);
+}
+
+
+static FORCEINLINE __m512i set_m128i(__m128i x0, __m128i x1, __m128i x2, __m128i x3)
+{
+    __m512i r = _mm512_maskz_broadcast_i32x4(0xFFFF, x0);
+    r = _mm512_inserti32x4(r, x1, 1);
+    r = _mm512_inserti32x4(r, x2, 2);
+    return _mm512_inserti32x4(r, x3, 3);
+}
+
+
+static NOINLINE void vaes512_genkey_quad(const __m128i* const (&memory)[4], __m512i (&k)[10])
+{
+    __m128i xout0[4];
+    __m128i xout2[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        xout0[i] = _mm_load_si128(memory[i]);
+        xout2[i] = _mm_load_si128(memory[i] + 1);
+    }
+
+    k[0] = set_m128i(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[1] = set_m128i(xout2[0], xout2[1], xout2[2], xout2[3]);
+
+    for (size_t i = 0; i < 4; ++i) { aes_genkey_sub<0x01>(&xout0[i], &xout2[i]); }
+    k[2] = set_m128i(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[3] = set_m128i(xout2[0], xout2[1], xout2[2], xout2[3]);
+
+    for (size_t i = 0; i < 4; ++i) { aes_genkey_sub<0x02>(&xout0[i], &xout2[i]); }
+    k[4] = set_m128i(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[5] = set_m128i(xout2[0], xout2[1], xout2[2], xout2[3]);
+
+    for (size_t i = 0; i < 4; ++i) { aes_genkey_sub<0x04>(&xout0[i], &xout2[i]); }
+    k[6] = set_m128i(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[7] = set_m128i(xout2[0], xout2[1], xout2[2], xout2[3]);
+
+    for (size_t i = 0; i < 4; ++i) { aes_genkey_sub<0x08>(&xout0[i], &xout2[i]); }
+    k[8] = set_m128i(xout0[0], xout0[1], xout0[2], xout0[3]);
+    k[9] = set_m128i(xout2[0], xout2[1], xout2[2], xout2[3]);
+}
+
+
+static FORCEINLINE void vaes512_rounds(const __m512i (&k)[10], __m512i (&x)[8])
+{
+    for (size_t r = 0; r < 10; ++r) {
+        x[0] = _mm512_aesenc_epi128(x[0], k[r]);
+        x[1] = _mm512_aesenc_epi128(x[1], k[r]);
+        x[2] = _mm512_aesenc_epi128(x[2], k[r]);
+        x[3] = _mm512_aesenc_epi128(x[3], k[r]);
+        x[4] = _mm512_aesenc_epi128(x[4], k[r]);
+        x[5] = _mm512_aesenc_epi128(x[5], k[r]);
+        x[6] = _mm512_aesenc_epi128(x[6], k[r]);
+        x[7] = _mm512_aesenc_epi128(x[7], k[r]);
+    }
+}
+
+
+// 4x4 transpose of 16-byte blocks: "block j of hashes 0-3" <-> "blocks 0-3 of hash j".
+// Full-mask zeroing shuffles, the plain intrinsic passes an undefined vector that GCC reports as uninitialized.
+static FORCEINLINE void transpose(__m512i& x0, __m512i& x1, __m512i& x2, __m512i& x3)
+{
+    const __m512i t0 = _mm512_maskz_shuffle_i64x2(0xFF, x0, x1, 0x44);
+    const __m512i t1 = _mm512_maskz_shuffle_i64x2(0xFF, x0, x1, 0xEE);
+    const __m512i t2 = _mm512_maskz_shuffle_i64x2(0xFF, x2, x3, 0x44);
+    const __m512i t3 = _mm512_maskz_shuffle_i64x2(0xFF, x2, x3, 0xEE);
+
+    x0 = _mm512_maskz_shuffle_i64x2(0xFF, t0, t2, 0x88);
+    x1 = _mm512_maskz_shuffle_i64x2(0xFF, t0, t2, 0xDD);
+    x2 = _mm512_maskz_shuffle_i64x2(0xFF, t1, t3, 0x88);
+    x3 = _mm512_maskz_shuffle_i64x2(0xFF, t1, t3, 0xDD);
+}
+
+
+// Loads 8 consecutive blocks of each hash
+static FORCEINLINE void load_blocks(const __m128i* const (&p)[4], __m512i (&x)[8])
+{
+    for (size_t i = 0; i < 4; ++i) {
+        x[i]     = _mm512_loadu_si512(p[i]);
+        x[i + 4] = _mm512_loadu_si512(p[i] + 4);
+    }
+
+    transpose(x[0], x[1], x[2], x[3]);
+    transpose(x[4], x[5], x[6], x[7]);
+}
+
+
+// Stores 8 consecutive blocks of each hash, "x" is not preserved
+static FORCEINLINE void store_blocks(__m128i* const (&p)[4], __m512i (&x)[8])
+{
+    transpose(x[0], x[1], x[2], x[3]);
+    transpose(x[4], x[5], x[6], x[7]);
+
+    for (size_t i = 0; i < 4; ++i) {
+        _mm512_storeu_si512(p[i], x[i]);
+        _mm512_storeu_si512(p[i] + 4, x[i + 4]);
+    }
+}
+
+
+namespace xmrig {
+
+
+NOINLINE void cn_explode_scratchpad_vaes_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem)
+{
+    const size_t N = (memory / sizeof(__m128i)) / (half_mem ? 2 : 1);
+
+    __m512i x[8];
+    __m512i k[10];
+
+    const __m128i* input[4];
+    __m128i* output[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        input[i]  = reinterpret_cast<const __m128i*>(ctx[i]->state);
+        output[i] = reinterpret_cast<__m128i*>(ctx[i]->memory);
+    }
+
+    vaes512_genkey_quad(input, k);
+
+    {
+        const bool b = half_mem && !ctx[0]->first_half && !ctx[1]->first_half && !ctx[2]->first_half && !ctx[3]->first_half;
+        const __m128i* p[4];
+        for (size_t i = 0; i < 4; ++i) {
+            p[i] = b ? reinterpret_cast<const __m128i*>(ctx[i]->save_state) : (input[i] + 4);
+        }
+
+        load_blocks(p, x);
+    }
+
+    constexpr int output_increment = 64 / sizeof(__m128i);
+    constexpr int prefetch_dist = 2048 / sizeof(__m128i);
+
+    __m128i* e = output[0] + N - prefetch_dist;
+    size_t prefetch_offset = prefetch_dist;
+
+    for (int i = 0; i < 2; ++i) {
+        do {
+            for (size_t j = 0; j < 4; ++j) {
+                _mm_prefetch((const char*)(output[j] + prefetch_offset), _MM_HINT_T0);
+                _mm_prefetch((const char*)(output[j] + prefetch_offset + output_increment), _MM_HINT_T0);
+            }
+
+            vaes512_rounds(k, x);
+
+            // Keep the state in registers, the transposed copy is only used for storing
+            __m512i y[8] = { x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7] };
+            store_blocks(output, y);
+
+            for (size_t j = 0; j < 4; ++j) {
+                output[j] += output_increment * 2;
+            }
+        } while (output[0] < e);
+        e += prefetch_dist;
+        prefetch_offset = 0;
+    }
+
+    if (half_mem && ctx[0]->first_half && ctx[1]->first_half && ctx[2]->first_half && ctx[3]->first_half) {
+        __m128i* p[4];
+        for (size_t i = 0; i < 4; ++i) {
+            p[i] = reinterpret_cast<__m128i*>(ctx[i]->save_state);
+        }
+
+        store_blocks(p, x);
+    }
+
+    _mm256_zeroupper();
+}
+
+
+NOINLINE void cn_implode_scratchpad_vaes_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem)
+{
+    const size_t N = (memory / sizeof(__m128i)) / (half_mem ? 2 : 1);
+
+    __m512i x[8];
+    __m512i k[10];
+
+    const __m128i* input[4];
+    __m128i* output[4];
+    const __m128i* keys[4];
+    const __m128i* state[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        input[i]  = reinterpret_cast<const __m128i*>(ctx[i]->memory);
+        output[i] = reinterpret_cast<__m128i*>(ctx[i]->state) + 4;
+        keys[i]   = reinterpret_cast<const __m128i*>(ctx[i]->state) + 2;
+        state[i]  = output[i];
+    }
+
+    vaes512_genkey_quad(keys, k);
+    load_blocks(state, x);
+
+    const __m128i* input_begin[4] = { input[0], input[1], input[2], input[3] };
+
+    for (size_t part = 0; part < (half_mem ? 2 : 1); ++part) {
+        if (half_mem && (part == 1)) {
+            for (size_t i = 0; i < 4; ++i) {
+                input[i] = input_begin[i];
+                ctx[i]->first_half = false;
+            }
+
+            cn_explode_scratchpad_vaes_quad(ctx, memory, half_mem);
+        }
+
+        for (size_t i = 0; i < N;) {
+            __m512i y[8];
+            load_blocks(input, y);
+
+            for (size_t j = 0; j < 8; ++j) {
+                x[j] = _mm512_xor_si512(x[j], y[j]);
+            }
+
+            constexpr int input_increment = 64 / sizeof(__m128i);
+
+            for (size_t j = 0; j < 4; ++j) {
+                input[j] += input_increment * 2;
+            }
+            i += 8;
+
+            if (i < N) {
+                for (size_t j = 0; j < 4; ++j) {
+                    _mm_prefetch((const char*)(input[j]), _MM_HINT_T0);
+                    _mm_prefetch((const char*)(input[j] + input_increment), _MM_HINT_T0);
+                }
+            }
+
+            vaes512_rounds(k, x);
+        }
+    }
+
+    store_blocks(output, x);
+
+    _mm256_zeroupper();
+}
+
+
+} // xmrig
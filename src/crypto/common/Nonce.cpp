@@ -17,27 +17,62 @@
  */
 
 #include "base/tools/Alignment.h"
+#include "base/tools/Chrono.h"
 #include "crypto/common/Nonce.h"
 
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+
 namespace xmrig {
 
 std::atomic<bool> Nonce::m_paused = {true};
+std::atomic<uint64_t> Nonce::m_generation = {0};
+std::atomic<uint64_t> Nonce::m_signalTime = {0};
 std::atomic<uint64_t>  Nonce::m_sequence[Nonce::MAX] = { {1}, {1}, {1} };
+std::atomic<uint64_t> Nonce::m_epoch[2] = { {0}, {0} };
 std::atomic<uint64_t> Nonce::m_nonces[2] = { {0}, {0} };
 
 
-} // namespace xmrig
+static constexpr uint32_t kMaxNodes     = 64;
+static constexpr uint64_t kNodeChunks   = 32;           // reservations per node chunk
+static constexpr uint64_t kNodeChunkMax = 1U << 24;
 
 
-bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask)
+// Nonces taken from the global counter for one NUMA node, only threads of this node use its mutex.
+struct alignas(64) NodeRange
 {
-    mask &= 0x7FFFFFFFFFFFFFFFULL;
-    if (reserveCount == 0 || mask < reserveCount - 1) {
-        return false;
+    std::mutex mutex;
+    uint64_t epoch  = 0;
+    uint64_t next   = 0;
+    uint64_t end    = 0;
+};
+
+
+static NodeRange nodeRanges[2][kMaxNodes];
+static std::condition_variable waitCv;
+static std::mutex waitMutex;
+static constexpr auto kWaitTimeout = std::chrono::milliseconds(1000);   // only a safety net, every state change notifies
+
+
+static inline void writeNonce(uint32_t *nonce, uint64_t counter, uint64_t mask)
+{
+    writeUnaligned(nonce, static_cast<uint32_t>((readUnaligned(nonce) & ~mask) | counter));
+
+    if (mask > 0xFFFFFFFFULL) {
+        writeUnaligned(nonce + 1, static_cast<uint32_t>((readUnaligned(nonce + 1) & (~mask >> 32)) | (counter >> 32)));
     }
+}
+
 
-    uint64_t counter = m_nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
+} // namespace xmrig
+
+
+bool xmrig::Nonce::reserve(uint8_t index, uint64_t &counter, uint64_t reserveCount, uint64_t mask)
+{
+    counter = m_nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
     while (true) {
         if (mask < counter) {
             return false;
@@ -54,14 +89,65 @@ bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, u
             continue;
         }
 
-        writeUnaligned(nonce, static_cast<uint32_t>((readUnaligned(nonce) & ~mask) | counter));
+        return true;
+    }
+}
 
-        if (mask > 0xFFFFFFFFULL) {
-            writeUnaligned(nonce + 1, static_cast<uint32_t>((readUnaligned(nonce + 1) & (~mask >> 32)) | (counter >> 32)));
+
+bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask, uint32_t node)
+{
+    mask &= 0x7FFFFFFFFFFFFFFFULL;
+    if (reserveCount == 0 || mask < reserveCount - 1) {
+        return false;
+    }
+
+    // Narrow nonce space (nicehash, extranonce) is left to the global counter, node chunks would exhaust it too early
+    if (node < kMaxNodes && mask >= 0xFFFFFFFFULL) {
+        NodeRange &range = nodeRanges[index][node];
+        std::lock_guard<std::mutex> lock(range.mutex);
+
+        // The epoch is read before the chunk is taken, so a chunk racing with reset() is dropped on next use
+        const uint64_t epoch = m_epoch[index].load();
+        if (range.epoch != epoch || range.end - range.next < reserveCount) {
+            const uint64_t size = std::max<uint64_t>(reserveCount, std::min<uint64_t>(reserveCount * kNodeChunks, kNodeChunkMax));
+            uint64_t counter    = 0;
+
+            if (!reserve(index, counter, size, mask)) {
+                return false;
+            }
+
+            range.epoch = epoch;
+            range.next  = counter;
+            range.end   = counter + size;
         }
 
+        writeNonce(nonce, range.next, mask);
+        range.next += reserveCount;
+
         return true;
     }
+
+    uint64_t counter = 0;
+    if (!reserve(index, counter, reserveCount, mask)) {
+        return false;
+    }
+
+    writeNonce(nonce, counter, mask);
+
+    return true;
+}
+
+
+void xmrig::Nonce::notify()
+{
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+
+        m_signalTime.store(static_cast<uint64_t>(Chrono::highResolutionMSecs() * 1000.0), std::memory_order_relaxed);
+        m_generation++;
+    }
+
+    waitCv.notify_all();
 }
 
 
@@ -72,6 +158,8 @@ void xmrig::Nonce::stop()
     for (auto &i : m_sequence) {
         i = 0;
     }
+
+    notify();
 }
 
 
@@ -80,4 +168,14 @@ void xmrig::Nonce::touch()
     for (auto &i : m_sequence) {
         i++;
     }
+
+    notify();
+}
+
+
+void xmrig::Nonce::wait(uint64_t generation)
+{
+    std::unique_lock<std::mutex> lock(waitMutex);
+
+    waitCv.wait_for(lock, kWaitTimeout, [generation] { return m_generation.load() != generation; });
 }
@@ -36,22 +36,36 @@ public:
         MAX
     };
 
+    static constexpr uint32_t kNoNode = 0xFFFFFFFFU;
+
 
     static inline bool isOutdated(Backend backend, uint64_t sequence)   { return m_sequence[backend].load(std::memory_order_relaxed) != sequence; }
     static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
+    static inline uint64_t generation()                                 { return m_generation.load(); }
     static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
-    static inline void pause(bool paused)                               { m_paused = paused; }
-    static inline void reset(uint8_t index)                             { m_nonces[index] = 0; }
-    static inline void stop(Backend backend)                            { m_sequence[backend] = 0; }
-    static inline void touch(Backend backend)                           { m_sequence[backend]++; }
+    static inline uint64_t signalTime()                                 { return m_signalTime.load(std::memory_order_relaxed); }
+    static inline void pause(bool paused)                               { m_paused = paused; if (!paused) { notify(); } }
+    static inline void reset(uint8_t index)                             { m_nonces[index] = 0; m_epoch[index]++; }
+    static inline void stop(Backend backend)                            { m_sequence[backend] = 0; notify(); }
+    static inline void touch(Backend backend)                           { m_sequence[backend]++; notify(); }
 
-    static bool next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask);
+    // If "node" is set, the reservation is taken from a chunk of the global counter cached for this NUMA node
+    static bool next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask, uint32_t node = kNoNode);
+    static void notify();
     static void stop();
     static void touch();
 
+    // Blocks until notify() is called after generation() returned "generation", the caller re-checks its own condition
+    static void wait(uint64_t generation);
+
 private:
+    static bool reserve(uint8_t index, uint64_t &counter, uint64_t reserveCount, uint64_t mask);
+
     static std::atomic<bool> m_paused;
+    static std::atomic<uint64_t> m_generation;
+    static std::atomic<uint64_t> m_signalTime;
     static std::atomic<uint64_t> m_sequence[MAX];
+    static std::atomic<uint64_t> m_epoch[2];
     static std::atomic<uint64_t> m_nonces[2];
 };
 
@@ -3,8 +3,11 @@
 #include <string.h>
 #include <stdbool.h>
 
+#include <algorithm>
+
+#include "crypto/flex/flex.h"
 #include "crypto/cn/CnHash.h"
-#include "backend/cpu/Cpu.h"
+#include "crypto/cn/CryptoNight.h"
 
 extern "C" {
 #include "../randomx/panthera/sysendian.h"
@@ -24,8 +27,9 @@ extern "C" {
 #include "../ghostrider/sph_whirlpool.h"
 #include "../ghostrider/sph_sha2.h"
 #include "./flex_keccak.h"
+#include "../cn/c_blake256.h"
+#include "../cn/c_skein.h"
 }
-#include <stdio.h>
 
 using namespace xmrig;
 
@@ -76,10 +80,7 @@ static void selectAlgo(unsigned char nibble, bool* selectedAlgos, uint8_t* selec
 static void getAlgoString(void *mem, unsigned int size, uint8_t* selectedAlgoOutput, int algoCount) {
   unsigned char *p = (unsigned char *)mem;
   unsigned int len = size/2;
-  bool* selectedAlgo = new bool[algoCount];
-  for(int z=0; z < algoCount; z++) {
-	  selectedAlgo[z] = false;
-  }
+  bool selectedAlgo[HASH_FUNC_COUNT] = {};
   int selectedCount = 0;
   for (unsigned int i=0;i<len; i++) {
 	  selectAlgo(p[i], selectedAlgo, selectedAlgoOutput, algoCount, &selectedCount);
@@ -95,205 +96,271 @@ static void getAlgoString(void *mem, unsigned int size, uint8_t* selectedAlgoOut
 		}
 	}
   }
-  delete [] selectedAlgo;
 }
 
-void print_hex_memory(void *mem, unsigned int size) {
-  unsigned char *p = (unsigned char *)mem;
-  unsigned int len = size/2;
-  for (unsigned int i=0;i<len; i++) {
-    printf("%02x", p[(len - i - 1)]);
-  }
-  printf("\n");
+
+// The first keccak absorbs the 80 byte header, only the last 4 bytes (the nonce) change between hashes
+static constexpr size_t kPrefixSize = 76;
+
+
+// CN rounds are batched across lanes that selected the same variant, up to this many lanes per call
+static constexpr size_t kMaxCnWays = 4;
+
+
+struct xmrig::flex::FlexCtx
+{
+	sph_blake512_context blake;
+	sph_bmw512_context bmw;
+	sph_groestl512_context groestl;
+	sph_keccak512_context keccak;
+	sph_skein512_context skein;
+	sph_luffa512_context luffa;
+	sph_cubehash512_context cubehash;
+	sph_shavite512_context shavite;
+	sph_simd512_context simd;
+	sph_echo512_context echo;
+	sph_hamsi512_context hamsi;
+	sph_fugue512_context fugue;
+	sph_shabal512_context shabal;
+	sph_whirlpool_context whirlpool;
+
+	sph_keccak512_context midstate;
+	uint8_t prefix[kPrefixSize];
+	bool hasMidstate;
+
+	// cn[variant][ways - 1] hashes "ways" lanes at once
+	cn_hash_fun cn[CN_HASH_FUNC_COUNT][kMaxCnWays];
+};
+
+
+xmrig::flex::FlexCtx* xmrig::flex::create_ctx(bool hwAES)
+{
+	static const Algorithm::Id cnAlgos[CN_HASH_FUNC_COUNT] = {
+		Algorithm::CN_GR_0, // CNDark
+		Algorithm::CN_GR_1, // CNDarklite
+		Algorithm::CN_GR_2, // CNFast
+		Algorithm::CN_GR_3, // CNLite
+		Algorithm::CN_GR_4, // CNTurtle
+		Algorithm::CN_GR_5, // CNTurtlelite
+	};
+
+	static const CnHash::AlgoVariant avHwAES[kMaxCnWays]   = { CnHash::AV_SINGLE, CnHash::AV_DOUBLE, CnHash::AV_TRIPLE, CnHash::AV_QUAD };
+	static const CnHash::AlgoVariant avSoftAES[kMaxCnWays] = { CnHash::AV_SINGLE_SOFT, CnHash::AV_DOUBLE_SOFT, CnHash::AV_TRIPLE_SOFT, CnHash::AV_QUAD_SOFT };
+
+	auto ctx = new FlexCtx();
+	const CnHash::AlgoVariant* av = hwAES ? avHwAES : avSoftAES;
+
+	for (int i = 0; i < CN_HASH_FUNC_COUNT; ++i) {
+		for (size_t j = 0; j < kMaxCnWays; ++j) {
+			ctx->cn[i][j] = CnHash::fn(cnAlgos[i], av[j], Assembly::AUTO);
+		}
+	}
+
+	return ctx;
 }
 
-void SwapBytes(void *pv, unsigned int n)
+
+void xmrig::flex::destroy_ctx(FlexCtx* ctx)
 {
-    char *p = (char*)pv;
-    unsigned int lo, hi;
-    for(lo=0, hi=n-1; hi>lo; lo++, hi--)
-    {
-        char tmp=p[lo];
-        p[lo] = p[hi];
-        p[hi] = tmp;
-    }
+	delete ctx;
 }
 
-void flex_hash(const char* input, char* output, cryptonight_ctx** ctx) {
-	uint32_t hash[64/4];
-	sph_blake512_context ctx_blake;
-	sph_bmw512_context ctx_bmw;
-	sph_groestl512_context ctx_groestl;
-	sph_keccak512_context ctx_keccak;
-	sph_skein512_context ctx_skein;
-	sph_luffa512_context ctx_luffa;
-	sph_cubehash512_context ctx_cubehash;
-	sph_shavite512_context ctx_shavite;
-	sph_simd512_context ctx_simd;
-	sph_echo512_context ctx_echo;
-	sph_hamsi512_context ctx_hamsi;
-	sph_fugue512_context ctx_fugue;
-	sph_shabal512_context ctx_shabal;
-	sph_whirlpool_context ctx_whirlpool;
-	void *in = (void*) input;
-	int size = 80;
-	flex_keccak512_init(&ctx_keccak);
-	flex_keccak512(&ctx_keccak, in, size);
-	flex_keccak512_close(&ctx_keccak, hash);
-	uint8_t selectedAlgoOutput[15] = {0};
-	uint8_t selectedCNAlgoOutput[14] = {0};
-	getAlgoString(&hash, 64, selectedAlgoOutput, 14);
-	getAlgoString(&hash, 64, selectedCNAlgoOutput, 6);
-	//printf("previous hash=");
-	//print_hex_memory(&input[4], 64);
-        const CnHash::AlgoVariant av = Cpu::info()->hasAES() ? CnHash::AV_SINGLE : CnHash::AV_SINGLE_SOFT;
-	int i;
-	for (i = 0; i < 18; i++)
-	{
-		uint8_t algo;
-		uint8_t cnAlgo;
-		int coreSelection;
-		int cnSelection = -1;
-		if(i < 5) {
-			coreSelection = i;
-		} else if(i < 11) {
-			coreSelection = i-1;
-		} else {
-			coreSelection = i-2;
-		}
-		if(i==5) {
-			coreSelection = -1;
-			cnSelection = 0;
-		}
-		if(i==11) {
-			coreSelection = -1;
-			cnSelection = 1;
-		}
-		if(i==17) {
-			coreSelection = -1;
-			cnSelection = 2;
-		}
-		if(coreSelection >= 0) {
-			algo = selectedAlgoOutput[(uint8_t)coreSelection];
-		} else {
-			algo = 16; // skip core hashing for this loop iteration
-		}
-		if(cnSelection >=0) {
-			cnAlgo = selectedCNAlgoOutput[(uint8_t)cnSelection];
-		} else {
-			cnAlgo = 14; // skip cn hashing for this loop iteration
-		}
-		//selection cnAlgo. if a CN algo is selected then core algo will not be selected
-                cn_hash_fun f;
-		switch(cnAlgo)
-		{
-		 case CNDark:
-                        //cryptonightdark_hash((const char*)in, (char*)hash, size, 1); 
-                        f = CnHash::fn(Algorithm::CN_GR_0, av, Assembly::AUTO); 
+
+static void core_hash(xmrig::flex::FlexCtx* fc, uint8_t algo, const void* in, size_t size, uint32_t* hash)
+{
+	switch (algo) {
+	case BLAKE:
+			sph_blake512_init(&fc->blake);
+			sph_blake512(&fc->blake, in, size);
+			sph_blake512_close(&fc->blake, hash);
+			break;
+	case BMW:
+			sph_bmw512_init(&fc->bmw);
+			sph_bmw512(&fc->bmw, in, size);
+			sph_bmw512_close(&fc->bmw, hash);
+			break;
+	case GROESTL:
+			sph_groestl512_init(&fc->groestl);
+			sph_groestl512(&fc->groestl, in, size);
+			sph_groestl512_close(&fc->groestl, hash);
+			break;
+	case KECCAK:
+			flex_keccak512_init(&fc->keccak);
+			flex_keccak512(&fc->keccak, in, size);
+			flex_keccak512_close(&fc->keccak, hash);
+			break;
+	case SKEIN:
+			sph_skein512_init(&fc->skein);
+			sph_skein512(&fc->skein, in, size);
+			sph_skein512_close(&fc->skein, hash);
 			break;
-		 case CNDarklite:
-                        //cryptonightdarklite_hash((const char*)in, (char*)hash, size, 1);
-                        f = CnHash::fn(Algorithm::CN_GR_1, av, Assembly::AUTO);
+	case LUFFA:
+			sph_luffa512_init(&fc->luffa);
+			sph_luffa512(&fc->luffa, in, size);
+			sph_luffa512_close(&fc->luffa, hash);
 			break;
-		 case CNFast:
-                        //cryptonightfast_hash((const char*)in, (char*)hash, size, 1);
-                        f = CnHash::fn(Algorithm::CN_GR_2, av, Assembly::AUTO);
+	case CUBEHASH:
+			sph_cubehash512_init(&fc->cubehash);
+			sph_cubehash512(&fc->cubehash, in, size);
+			sph_cubehash512_close(&fc->cubehash, hash);
 			break;
-		 case CNLite:
-                        //cryptonightlite_hash((const char*)in, (char*)hash, size, 1);
-                        f = CnHash::fn(Algorithm::CN_GR_3, av, Assembly::AUTO);
+	case SHAVITE:
+			sph_shavite512_init(&fc->shavite);
+			sph_shavite512(&fc->shavite, in, size);
+			sph_shavite512_close(&fc->shavite, hash);
 			break;
-		 case CNTurtle:
-                        //cryptonightturtle_hash((const char*)in, (char*)hash, size, 1); 
-                        f = CnHash::fn(Algorithm::CN_GR_4, av, Assembly::AUTO);
+	case SIMD:
+			sph_simd512_init(&fc->simd);
+			sph_simd512(&fc->simd, in, size);
+			sph_simd512_close(&fc->simd, hash);
 			break;
-		 case CNTurtlelite:
-                        //cryptonightturtlelite_hash((const char*)in, (char*)hash, size, 1);
-                        f = CnHash::fn(Algorithm::CN_GR_5, av, Assembly::AUTO);
+	case ECHO:
+			sph_echo512_init(&fc->echo);
+			sph_echo512(&fc->echo, in, size);
+			sph_echo512_close(&fc->echo, hash);
 			break;
-                 default:
-                        f = nullptr;
+	case HAMSI:
+			sph_hamsi512_init(&fc->hamsi);
+			sph_hamsi512(&fc->hamsi, in, size);
+			sph_hamsi512_close(&fc->hamsi, hash);
+			break;
+	case FUGUE:
+			sph_fugue512_init(&fc->fugue);
+			sph_fugue512(&fc->fugue, in, size);
+			sph_fugue512_close(&fc->fugue, hash);
+			break;
+	case SHABAL:
+			sph_shabal512_init(&fc->shabal);
+			sph_shabal512(&fc->shabal, in, size);
+			sph_shabal512_close(&fc->shabal, hash);
+			break;
+	case WHIRLPOOL:
+			sph_whirlpool_init(&fc->whirlpool);
+			sph_whirlpool(&fc->whirlpool, in, size);
+			sph_whirlpool_close(&fc->whirlpool, hash);
+			break;
+	}
+}
+
+
+// Multi-way CN hashes finish with the regular CryptoNight extra hashes, redo it from the final keccak state like
+// extra_hashes_flex does: blake256 replaces the first 32 bytes of the lane hash, skein512 all 64
+static void cn_flex_final(const cryptonight_ctx* ctx, uint8_t* output)
+{
+	if (ctx->state[0] & 2) {
+		skein_hash(512, ctx->state, 200 * 8, output);
+	}
+	else {
+		blake256_hash(output, ctx->state, 200);
+	}
+}
+
+
+template<size_t N>
+void xmrig::flex::hash_multi(const uint8_t* input, size_t size, uint8_t* output, cryptonight_ctx** ctx, FlexCtx* fc)
+{
+	uint32_t hash[N][64/4];
+	uint8_t selectedAlgoOutput[N][15] = {};
+	uint8_t selectedCNAlgoOutput[N][14] = {};
+
+	// The algorithm order comes from the keccak of the whole header, so it differs between lanes
+	for (size_t lane = 0; lane < N; ++lane) {
+		const uint8_t* data = input + lane * size;
+
+		if (!fc->hasMidstate || memcmp(fc->prefix, data, kPrefixSize) != 0) {
+			memcpy(fc->prefix, data, kPrefixSize);
+			flex_keccak512_init(&fc->midstate);
+			flex_keccak512(&fc->midstate, data, kPrefixSize);
+			fc->hasMidstate = true;
+		}
+
+		fc->keccak = fc->midstate;
+		flex_keccak512(&fc->keccak, data + kPrefixSize, size - kPrefixSize);
+		flex_keccak512_close(&fc->keccak, hash[lane]);
+
+		getAlgoString(hash[lane], 64, selectedAlgoOutput[lane], 14);
+		getAlgoString(hash[lane], 64, selectedCNAlgoOutput[lane], 6);
+	}
+
+	for (int i = 0; i < 18; i++)
+	{
+		// Rounds 5, 11 and 17 run one of the selected CN variants, all others one of the core hashes
+		if (i == 5 || i == 11 || i == 17) {
+			for (uint8_t algo = 0; algo < CN_HASH_FUNC_COUNT; ++algo) {
+				size_t lanes[N];
+				size_t count = 0;
+
+				for (size_t lane = 0; lane < N; ++lane) {
+					if (selectedCNAlgoOutput[lane][i / 6] == algo) {
+						lanes[count++] = lane;
+					}
+				}
+
+				for (size_t first = 0; first < count;) {
+					size_t ways = std::min(count - first, kMaxCnWays);
+					while (ways > 1 && !fc->cn[algo][ways - 1]) {
+						--ways;
+					}
+
+					const cn_hash_fun f = fc->cn[algo][ways - 1];
+
+					// Height 101 makes the single hash finish with the Flex extra hash in place
+					if (f && ways == 1) {
+						f((const uint8_t*)hash[lanes[first]], 64, (uint8_t*)hash[lanes[first]], ctx + lanes[first], 101);
+					}
+					else if (f) {
+						uint8_t in[kMaxCnWays * 64];
+						uint8_t out[kMaxCnWays * 32];
+						cryptonight_ctx* cn_ctx[kMaxCnWays];
+
+						for (size_t j = 0; j < ways; ++j) {
+							memcpy(in + j * 64, hash[lanes[first + j]], 64);
+							cn_ctx[j] = ctx[lanes[first + j]];
+						}
+
+						f(in, 64, out, cn_ctx, 0);
+
+						for (size_t j = 0; j < ways; ++j) {
+							cn_flex_final(cn_ctx[j], (uint8_t*)hash[lanes[first + j]]);
+						}
+					}
+
+					first += ways;
+				}
+			}
 		}
-                if (f) f((const uint8_t*)in, size, (uint8_t*)hash, ctx, 101);
-
-		//selection core algo
-		switch (algo) {
-		case BLAKE:
-				sph_blake512_init(&ctx_blake);
-				sph_blake512(&ctx_blake, in, size);
-				sph_blake512_close(&ctx_blake, hash);
-				break;
-		case BMW:
-				sph_bmw512_init(&ctx_bmw);
-				sph_bmw512(&ctx_bmw, in, size);
-				sph_bmw512_close(&ctx_bmw, hash);
-				break;
-		case GROESTL:
-				sph_groestl512_init(&ctx_groestl);
-				sph_groestl512(&ctx_groestl, in, size);
-				sph_groestl512_close(&ctx_groestl, hash);
-				break;
-		case KECCAK:
-				flex_keccak512_init(&ctx_keccak);
-				flex_keccak512(&ctx_keccak, in, size);
-				flex_keccak512_close(&ctx_keccak, hash);
-				break;
-		case SKEIN:
-				sph_skein512_init(&ctx_skein);
-				sph_skein512(&ctx_skein, in, size);
-				sph_skein512_close(&ctx_skein, hash);
-				break;
-		case LUFFA:
-				sph_luffa512_init(&ctx_luffa);
-				sph_luffa512(&ctx_luffa, in, size);
-				sph_luffa512_close(&ctx_luffa, hash);
-				break;
-		case CUBEHASH:
-				sph_cubehash512_init(&ctx_cubehash);
-				sph_cubehash512(&ctx_cubehash, in, size);
-				sph_cubehash512_close(&ctx_cubehash, hash);
-				break;
-		case SHAVITE:
-				sph_shavite512_init(&ctx_shavite);
-				sph_shavite512(&ctx_shavite, in, size);
-				sph_shavite512_close(&ctx_shavite, hash);
-				break;
-		case SIMD:
-				sph_simd512_init(&ctx_simd);
-				sph_simd512(&ctx_simd, in, size);
-				sph_simd512_close(&ctx_simd, hash);
-				break;
-		case ECHO:
-				sph_echo512_init(&ctx_echo);
-				sph_echo512(&ctx_echo, in, size);
-				sph_echo512_close(&ctx_echo, hash);
-				break;
-		case HAMSI:
-				sph_hamsi512_init(&ctx_hamsi);
-				sph_hamsi512(&ctx_hamsi, in, size);
-				sph_hamsi512_close(&ctx_hamsi, hash);
-				break;
-		case FUGUE:
-				sph_fugue512_init(&ctx_fugue);
-				sph_fugue512(&ctx_fugue, in, size);
-				sph_fugue512_close(&ctx_fugue, hash);
-				break;
-		case SHABAL:
-				sph_shabal512_init(&ctx_shabal);
-				sph_shabal512(&ctx_shabal, in, size);
-				sph_shabal512_close(&ctx_shabal, hash);
-				break;
-		case WHIRLPOOL:
-				sph_whirlpool_init(&ctx_whirlpool);
-				sph_whirlpool(&ctx_whirlpool, in, size);
-				sph_whirlpool_close(&ctx_whirlpool, hash);
-				break;
+		else {
+			for (size_t lane = 0; lane < N; ++lane) {
+				const uint8_t algo = selectedAlgoOutput[lane][i - (i > 5) - (i > 11)];
+
+				if (i == 0) {
+					core_hash(fc, algo, input + lane * size, size, hash[lane]);
+				}
+				else {
+					core_hash(fc, algo, hash[lane], 64, hash[lane]);
+				}
+			}
 		}
-		in = (void*) hash;
-		size = 64;
 	}
-	flex_keccak256_init(&ctx_keccak);
-	flex_keccak256(&ctx_keccak, in, size);
-	flex_keccak256_close(&ctx_keccak, hash);
-	memcpy(output, hash, 32);
+
+	for (size_t lane = 0; lane < N; ++lane) {
+		flex_keccak256_init(&fc->keccak);
+		flex_keccak256(&fc->keccak, hash[lane], 64);
+		flex_keccak256_close(&fc->keccak, hash[lane]);
+		memcpy(output + lane * 32, hash[lane], 32);
+	}
 }
+
+
+namespace xmrig {
+namespace flex {
+
+template void hash_multi<1>(const uint8_t* input, size_t size, uint8_t* output, cryptonight_ctx** ctx, FlexCtx* fc);
+template void hash_multi<2>(const uint8_t* input, size_t size, uint8_t* output, cryptonight_ctx** ctx, FlexCtx* fc);
+template void hash_multi<3>(const uint8_t* input, size_t size, uint8_t* output, cryptonight_ctx** ctx, FlexCtx* fc);
+template void hash_multi<4>(const uint8_t* input, size_t size, uint8_t* output, cryptonight_ctx** ctx, FlexCtx* fc);
+template void hash_multi<5>(const uint8_t* input, size_t size, uint8_t* output, cryptonight_ctx** ctx, FlexCtx* fc);
+template void hash_multi<8>(const uint8_t* input, size_t size, uint8_t* output, cryptonight_ctx** ctx, FlexCtx* fc);
+
+} // namespace flex
+} // namespace xmrig
@@ -1,4 +1,22 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 struct cryptonight_ctx;
-void flex_hash(const char* input, char* output, cryptonight_ctx** ctx);
+
+namespace xmrig {
+namespace flex {
+
+// Per-thread Flex state: sph contexts, CN function table and the keccak midstate of the block header prefix
+struct FlexCtx;
+
+FlexCtx* create_ctx(bool hwAES);
+void destroy_ctx(FlexCtx* ctx);
+
+// Hashes N headers of "size" bytes stored back to back, lanes that selected the same CN variant share one multi-way CN call
+template<size_t N>
+void hash_multi(const uint8_t* input, size_t size, uint8_t* output, cryptonight_ctx** ctx, FlexCtx* flexCtx);
+
+} // namespace flex
+} // namespace xmrig
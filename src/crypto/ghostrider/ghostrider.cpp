@@ -33,6 +33,11 @@
 #include "sph_shabal.h"
 #include "sph_whirlpool.h"
 
+#ifdef XMRIG_FEATURE_AVX2
+#   include "ghostrider_mb.h"
+#endif
+
+#include "3rdparty/rapidjson/document.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/tools/Chrono.h"
@@ -42,14 +47,24 @@
 #include "crypto/cn/CryptoNight.h"
 #include "crypto/common/VirtualMemory.h"
 
+#include <algorithm>
 #include <thread>
 #include <atomic>
+#include <cmath>
+#include <mutex>
+#include <string>
 #include <uv.h>
 
 #ifdef XMRIG_FEATURE_HWLOC
 #   include "base/kernel/Platform.h"
 #   include <hwloc.h>
 
+#   ifdef XMRIG_OS_LINUX
+#       include <linux/futex.h>
+#       include <sys/syscall.h>
+#       include <unistd.h>
+#   endif
+
 #   if HWLOC_API_VERSION < 0x20000
 #       define HWLOC_OBJ_L3CACHE HWLOC_OBJ_CACHE
 #   endif
@@ -117,6 +132,16 @@ static constexpr const char* cn_names[6] = {
     "cn/turtle-lite (128 KB)",
 };
 
+// Names used in the persisted tuning table
+static constexpr const char* cn_keys[6] = {
+    "cn/dark",
+    "cn/dark-lite",
+    "cn/fast",
+    "cn/lite",
+    "cn/turtle",
+    "cn/turtle-lite",
+};
+
 static constexpr size_t cn_sizes[6] = {
     Algorithm::l3(Algorithm::CN_GR_0),     // 512 KB
     Algorithm::l3(Algorithm::CN_GR_1) / 2, // 256 KB
@@ -126,8 +151,15 @@ static constexpr size_t cn_sizes[6] = {
     Algorithm::l3(Algorithm::CN_GR_5) / 2, // 128 KB
 };
 
-static constexpr CnHash::AlgoVariant av_hw_aes[5] = { CnHash::AV_SINGLE, CnHash::AV_SINGLE, CnHash::AV_DOUBLE, CnHash::AV_TRIPLE, CnHash::AV_QUAD };
-static constexpr CnHash::AlgoVariant av_soft_aes[5] = { CnHash::AV_SINGLE_SOFT, CnHash::AV_SINGLE_SOFT, CnHash::AV_DOUBLE_SOFT, CnHash::AV_TRIPLE_SOFT, CnHash::AV_QUAD_SOFT };
+// Indexed by step (hashes per CnHash call), only power of 2 steps are used
+static constexpr CnHash::AlgoVariant av_hw_aes[9] = { CnHash::AV_SINGLE, CnHash::AV_SINGLE, CnHash::AV_DOUBLE, CnHash::AV_TRIPLE, CnHash::AV_QUAD, CnHash::AV_PENTA, CnHash::AV_AUTO, CnHash::AV_AUTO, CnHash::AV_OCTA };
+static constexpr CnHash::AlgoVariant av_soft_aes[9] = { CnHash::AV_SINGLE_SOFT, CnHash::AV_SINGLE_SOFT, CnHash::AV_DOUBLE_SOFT, CnHash::AV_TRIPLE_SOFT, CnHash::AV_QUAD_SOFT, CnHash::AV_PENTA_SOFT, CnHash::AV_AUTO, CnHash::AV_AUTO, CnHash::AV_OCTA_SOFT };
+
+#if defined(XMRIG_ARM) || defined(XMRIG_RISCV)
+static constexpr uint32_t kMaxStep = 4;
+#else
+static constexpr uint32_t kMaxStep = 8;
+#endif
 
 template<size_t N>
 static inline void select_indices(uint32_t (&indices)[N], const uint8_t* seed)
@@ -158,6 +190,72 @@ namespace ghostrider
 {
 
 
+#ifdef XMRIG_FEATURE_AVX2
+struct MultiBuffer
+{
+    core_hash_mb_func fn4[15]{};
+    core_hash_mb_func fn8[15]{};
+
+    MultiBuffer()
+    {
+        const bool avx2   = Cpu::info()->has(ICpuInfo::FLAG_AVX2);
+        const bool avx512 = Cpu::info()->has(ICpuInfo::FLAG_AVX512F);
+
+        for (uint32_t i = 0; i < 15; ++i) {
+            fn4[i] = avx2 ? core_hash_avx2(i) : nullptr;
+            fn8[i] = avx512 ? core_hash_avx512(i) : nullptr;
+        }
+    }
+};
+#endif
+
+
+// Packs scratchpads of lanes [begin; end) by the real size of the current CN variant: lanes hashed by the same
+// CnHash call ("step" lanes) are placed back to back starting from "memory" and every call reuses that memory.
+// Scratchpads of all 8 lanes are allocated contiguously (2 MB each), so one call can span several of them.
+static inline void pack_scratchpads(cryptonight_ctx** ctx, uint8_t* memory, size_t begin, size_t end, size_t step, size_t size)
+{
+    for (size_t i = begin; i < end; ++i) {
+        ctx[i]->memory = memory + ((i - begin) % step) * size;
+    }
+}
+
+
+// Hashes lanes [begin; end) of a GhostRider core hash step, inputs are stored back to back with stride "size"
+static void core_hash_lanes(uint32_t index, const uint8_t* input, size_t size, uint8_t* output, size_t begin, size_t end)
+{
+#   ifdef XMRIG_FEATURE_AVX2
+    if (size <= kMaxMultiBufferSize) {
+        static const MultiBuffer mb;
+
+        if (mb.fn8[index]) {
+            for (; begin + 8 <= end; begin += 8) {
+                mb.fn8[index](input + begin * size, size, output + begin * 64);
+            }
+        }
+
+        if (mb.fn4[index]) {
+            for (; begin + 4 <= end; begin += 4) {
+                mb.fn4[index](input + begin * size, size, output + begin * 64);
+            }
+        }
+    }
+#   endif
+
+    for (; begin < end; ++begin) {
+        core_hash[index](input + begin * size, size, output + begin * 64);
+    }
+}
+
+
+// Tuning tables for all CPUs sharing the config file, keyed by tune_key()
+static std::mutex tuneMutex;
+static rapidjson::Document tuneDoc(rapidjson::kObjectType);
+static std::atomic<uint32_t> tuneVersion{ 0 };
+static std::atomic<bool> liveTune{ false };
+static bool tuned = false;
+
+
 #ifdef XMRIG_FEATURE_HWLOC
 
 
@@ -169,33 +267,323 @@ static struct AlgoTune
 } tuneDefault[6], tune8MB[6];
 
 
+// Live timings for every step (1, 2, 4, 8) and threads (1, 2) combination, indexed by candidate()
+struct LiveTune
+{
+    double hashrate;    // current combination only
+    double ratio;       // other combinations, relative to the current one
+    uint32_t samples;
+};
+
+static constexpr uint32_t kLiveExploreInterval  = 32;
+static constexpr uint32_t kLiveMinSamples       = 8;
+static constexpr double kLiveSmoothing          = 16.0;
+static constexpr double kLiveSwitchThreshold    = 1.05;
+
+static constexpr uint32_t kCandidates = 8;
+
+static LiveTune liveStats[2][6][kCandidates];
+static uint32_t liveCounter[2][6];
+static uint32_t liveNext[2][6];
+
+
+static inline uint32_t candidate(uint32_t step, uint32_t threads)   { return (step >= 4 ? (step >> 2) + 1 : step - 1) * 2 + threads - 1; }
+static inline uint32_t candidate_step(uint32_t c)                   { return 1U << (c >> 1); }
+static inline uint32_t candidate_threads(uint32_t c)                { return (c & 1) + 1; }
+
+
+static size_t max_scratchpad_size()
+{
+    static const size_t size = []() -> size_t {
+        if ((Cpu::info()->L3() >> 22) > Cpu::info()->cores()) {
+            // At least 1 core can run with 8 MB cache
+            return 1U << 23;
+        }
+
+        if ((Cpu::info()->L3() >> 22) >= Cpu::info()->cores()) {
+            // All cores can run with 4 MB cache
+            return 1U << 22;
+        }
+
+        // 2 MB cache per core by default
+        return 1U << 21;
+    }();
+
+    return size;
+}
+
+
+static bool is_feasible(uint32_t algo, uint32_t c, bool is8MB, bool helper)
+{
+    const uint32_t threads = candidate_threads(c);
+    const size_t size = cn_sizes[algo] * candidate_step(c) * threads;
+
+    return (helper || (threads == 1)) && (candidate_step(c) <= kMaxStep) && (candidate_step(c) * threads <= 8) && (size <= max_scratchpad_size()) && (is8MB || (size < (1U << 23)));
+}
+
+
+static void reset_live_tune()
+{
+    memset(liveStats, 0, sizeof(liveStats));
+    memset(liveCounter, 0, sizeof(liveCounter));
+    memset(liveNext, 0, sizeof(liveNext));
+}
+
+
+static void print_tune()
+{
+    LOG_VERBOSE("---------------------------------------------");
+    LOG_VERBOSE("|         GhostRider tuning results         |");
+    LOG_VERBOSE("---------------------------------------------");
+
+    for (int algo = 0; algo < 6; ++algo) {
+        LOG_VERBOSE("%24s | %ux%u | %.2f h/s", cn_names[algo], tuneDefault[algo].step, tuneDefault[algo].threads, tuneDefault[algo].hashrate);
+        if ((tune8MB[algo].step != tuneDefault[algo].step) || (tune8MB[algo].threads != tuneDefault[algo].threads)) {
+            LOG_VERBOSE("%24s | %ux%u | %.2f h/s", cn_names[algo], tune8MB[algo].step, tune8MB[algo].threads, tune8MB[algo].hashrate);
+        }
+    }
+}
+
+
+static bool read_table(const rapidjson::Value& value, const char* name, AlgoTune (&out)[6])
+{
+    const auto table = value.FindMember(name);
+    if ((table == value.MemberEnd()) || !table->value.IsObject()) {
+        return false;
+    }
+
+    for (size_t algo = 0; algo < 6; ++algo) {
+        const auto i = table->value.FindMember(cn_keys[algo]);
+        if ((i == table->value.MemberEnd()) || !i->value.IsArray() || (i->value.Size() != 3) || !i->value[0].IsUint() || !i->value[1].IsUint() || !i->value[2].IsNumber()) {
+            return false;
+        }
+
+        const uint32_t step    = i->value[0].GetUint();
+        const uint32_t threads = i->value[1].GetUint();
+
+        if ((step == 0) || (step > kMaxStep) || (step & (step - 1)) || ((threads != 1) && (threads != 2)) || (step * threads > 8)) {
+            return false;
+        }
+
+        out[algo].hashrate = i->value[2].GetDouble();
+        out[algo].step     = step;
+        out[algo].threads  = threads;
+    }
+
+    return true;
+}
+
+
+// Must be called with tuneMutex locked
+static bool load_tune()
+{
+    const auto i = tuneDoc.FindMember(tune_key());
+    if ((i == tuneDoc.MemberEnd()) || !i->value.IsObject()) {
+        return false;
+    }
+
+    AlgoTune newDefault[6];
+    AlgoTune new8MB[6];
+
+    if (!read_table(i->value, "default", newDefault) || !read_table(i->value, "8mb", new8MB)) {
+        return false;
+    }
+
+    for (size_t algo = 0; algo < 6; ++algo) {
+        tuneDefault[algo] = newDefault[algo];
+        tune8MB[algo]     = new8MB[algo];
+    }
+
+    reset_live_tune();
+
+    return true;
+}
+
+
+// Must be called with tuneMutex locked
+static rapidjson::Value table_to_json(rapidjson::Document& doc)
+{
+    using namespace rapidjson;
+    auto& allocator = doc.GetAllocator();
+
+    auto write = [&allocator](const AlgoTune (&tune)[6]) {
+        Value obj(kObjectType);
+
+        for (size_t algo = 0; algo < 6; ++algo) {
+            Value entry(kArrayType);
+            entry.PushBack(tune[algo].step, allocator);
+            entry.PushBack(tune[algo].threads, allocator);
+            entry.PushBack(std::round(tune[algo].hashrate * 100.0) / 100.0, allocator);
+
+            obj.AddMember(StringRef(cn_keys[algo]), entry, allocator);
+        }
+
+        return obj;
+    };
+
+    Value out(kObjectType);
+    out.AddMember("default", write(tuneDefault), allocator);
+    out.AddMember("8mb", write(tune8MB), allocator);
+
+    return out;
+}
+
+
+// Copies the tuning table for the next hash_octa call, in live mode every kLiveExploreInterval-th
+// call of each CN variant runs with another step/threads combination to collect its timings
+static bool select_tune(AlgoTune (&out)[3], const uint32_t* cn_indices, bool is8MB, bool helper)
+{
+    std::lock_guard<std::mutex> lock(tuneMutex);
+
+    const AlgoTune* tune = is8MB ? tune8MB : tuneDefault;
+    for (size_t i = 0; i < 3; ++i) {
+        out[i] = tune[cn_indices[i]];
+    }
+
+    if (!liveTune.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        const uint32_t algo = cn_indices[i];
+        if ((++liveCounter[is8MB][algo] % kLiveExploreInterval) != 0) {
+            continue;
+        }
+
+        const uint32_t cur = candidate(out[i].step, helper ? out[i].threads : 1);
+
+        for (uint32_t k = 0; k < kCandidates; ++k) {
+            const uint32_t c = liveNext[is8MB][algo]++ % kCandidates;
+            if ((c != cur) && is_feasible(algo, c, is8MB, helper)) {
+                out[i].step    = candidate_step(c);
+                out[i].threads = candidate_threads(c);
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// Folds the CN timings (in milliseconds for 8 hashes) of one hash_octa call into the live statistics.
+// Other step/threads combinations are rated relative to the current one measured at the same time,
+// so a slowdown of the whole machine doesn't favor combinations which were measured earlier.
+static void update_tune(const uint32_t* cn_indices, const AlgoTune (&used)[3], const double (&dt)[3], bool is8MB, bool helper)
+{
+    std::lock_guard<std::mutex> lock(tuneMutex);
+
+    AlgoTune* tune = is8MB ? tune8MB : tuneDefault;
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (dt[i] <= 0.0) {
+            continue;
+        }
+
+        const uint32_t algo = cn_indices[i];
+        LiveTune* stats = liveStats[is8MB][algo];
+        AlgoTune& t = tune[algo];
+
+        const uint32_t cur = candidate(t.step, helper ? t.threads : 1);
+        const uint32_t c   = candidate(used[i].step, helper ? used[i].threads : 1);
+        const double hashrate = 8e3 / dt[i];
+
+        if (c == cur) {
+            LiveTune& s = stats[cur];
+            s.hashrate = s.samples ? (s.hashrate + (hashrate - s.hashrate) / kLiveSmoothing) : hashrate;
+            ++s.samples;
+
+            t.hashrate = s.hashrate;
+            continue;
+        }
+
+        if (stats[cur].samples == 0) {
+            continue;
+        }
+
+        LiveTune& s = stats[c];
+        ++s.samples;
+        s.ratio += (hashrate / stats[cur].hashrate - s.ratio) / std::min(s.samples, kLiveMinSamples);
+
+        if ((s.samples < kLiveMinSamples) || (s.ratio < kLiveSwitchThreshold)) {
+            continue;
+        }
+
+        const double new_hashrate = stats[cur].hashrate * s.ratio;
+
+        LOG_INFO("%s GhostRider re-calibration: %s %ux%u -> %ux%u (%.2f -> %.2f h/s)",
+                 Tags::cpu(), cn_names[algo], t.step, t.threads, candidate_step(c), candidate_threads(c), stats[cur].hashrate, new_hashrate);
+
+        t.step     = candidate_step(c);
+        t.threads  = candidate_threads(c);
+        t.hashrate = new_hashrate;
+
+        // All ratios were relative to the previous combination
+        memset(stats, 0, sizeof(liveStats[0][0]));
+        stats[c].hashrate = new_hashrate;
+        stats[c].samples  = 1;
+
+        ++tuneVersion;
+    }
+}
+
+
+// Nanoseconds, for the helper thread statistics
+static inline uint64_t steady_nsecs()
+{
+    using namespace std::chrono;
+
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+
+// Single producer (worker thread), single consumer (helper thread) task ring. Both sides spin with
+// exponential backoff first and then go to sleep (futex on Linux), so an idle helper doesn't burn the core.
 struct HelperThread
 {
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(HelperThread)
 
+    static constexpr uint32_t kSlots            = 4;
+    static constexpr uint32_t kSpinLimit        = 4096;
+    static constexpr uint32_t kSpinMaxBatch     = 64;
+    static constexpr uint32_t kLatencyBuckets   = 8;
+
     HelperThread(hwloc_bitmap_t cpu_set, int priority, bool is8MB) : m_cpuSet(cpu_set), m_priority(priority), m_is8MB(is8MB)
     {
+#       ifndef XMRIG_OS_LINUX
         uv_mutex_init(&m_mutex);
         uv_cond_init(&m_cond);
+#       endif
+
+        m_created = steady_nsecs();
 
         m_thread = new std::thread(&HelperThread::run, this);
         do {
             std::this_thread::sleep_for(std::chrono::milliseconds(1));
         } while (!m_ready);
+
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        m_registry.push_back(this);
     }
 
     ~HelperThread()
     {
-        uv_mutex_lock(&m_mutex);
-        m_finished = true;
-        uv_cond_signal(&m_cond);
-        uv_mutex_unlock(&m_mutex);
+        {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            m_registry.erase(std::find(m_registry.begin(), m_registry.end(), this));
+        }
+
+        // An empty task wakes the helper thread up, so it can see m_finished
+        m_finished.store(true, std::memory_order_release);
+        launch_task([]() {});
 
         m_thread->join();
         delete m_thread;
 
+#       ifndef XMRIG_OS_LINUX
         uv_mutex_destroy(&m_mutex);
         uv_cond_destroy(&m_cond);
+#       endif
 
         hwloc_bitmap_free(m_cpuSet);
     }
@@ -229,16 +617,29 @@ struct HelperThread
     template<typename T>
     inline void launch_task(T&& task)
     {
-        uv_mutex_lock(&m_mutex);
-        new (&m_tasks[m_numTasks++]) Task<T>(std::forward<T>(task));
-        uv_cond_signal(&m_cond);
-        uv_mutex_unlock(&m_mutex);
+        const uint32_t head = m_head.load(std::memory_order_relaxed);
+
+        // All slots are busy, doesn't happen as long as callers wait() before launching more than kSlots tasks
+        while (head - m_tail.load(std::memory_order_acquire) >= kSlots) {
+            _mm_pause();
+        }
+
+        const uint32_t slot = head % kSlots;
+        new (&m_tasks[slot]) Task<T>(std::forward<T>(task));
+        m_launchTime[slot] = steady_nsecs();
+
+        m_head.store(head + 1, std::memory_order_seq_cst);
+        if (m_helperSleeping.load(std::memory_order_seq_cst)) {
+            wake(m_head);
+        }
     }
 
-    inline void wait() const
+    inline void wait()
     {
-        while (m_numTasks) {
-            _mm_pause();
+        const uint32_t head = m_head.load(std::memory_order_relaxed);
+
+        for (uint32_t tail = m_tail.load(std::memory_order_acquire); tail != head; tail = m_tail.load(std::memory_order_acquire)) {
+            wait_for_change(m_tail, tail, m_ownerSleeping);
         }
     }
 
@@ -253,32 +654,154 @@ struct HelperThread
 
         Platform::setThreadPriority(m_priority);
 
-        uv_mutex_lock(&m_mutex);
         m_ready = true;
 
-        do {
-            uv_cond_wait(&m_cond, &m_mutex);
+        for (uint32_t tail = 0;;) {
+            const uint32_t head = m_head.load(std::memory_order_acquire);
+
+            if (tail == head) {
+                if (m_finished.load(std::memory_order_acquire)) {
+                    break;
+                }
 
-            const uint32_t n = m_numTasks;
-            if (n > 0) {
-                for (uint32_t i = 0; i < n; ++i) {
-                    reinterpret_cast<TaskBase*>(&m_tasks[i])->run();
+                const uint64_t slept = wait_for_change(m_head, head, m_helperSleeping);
+                if (slept) {
+                    add(m_sleepTime, slept);
+                    add(m_sleeps, 1);
                 }
-                std::atomic_thread_fence(std::memory_order_seq_cst);
-                m_numTasks = 0;
+                continue;
+            }
+
+            const uint32_t slot = tail % kSlots;
+            const uint64_t start = steady_nsecs();
+
+            add(m_latency[latency_bucket(start - m_launchTime[slot])], 1);
+
+            reinterpret_cast<TaskBase*>(&m_tasks[slot])->run();
+
+            add(m_busyTime, steady_nsecs() - start);
+
+            m_tail.store(++tail, std::memory_order_seq_cst);
+            if (m_ownerSleeping.load(std::memory_order_seq_cst)) {
+                wake(m_tail);
             }
-        } while (!m_finished);
+        }
+    }
+
+    rapidjson::Value toJSON(rapidjson::Document& doc) const
+    {
+        using namespace rapidjson;
+        auto& allocator = doc.GetAllocator();
+
+        static const char* latency_names[kLatencyBuckets] = { "<256ns", "<1us", "<4us", "<16us", "<64us", "<256us", "<1ms", ">=1ms" };
+
+        const double elapsed = static_cast<double>(std::max<uint64_t>(steady_nsecs() - m_created, 1));
+
+        uint64_t tasks = 0;
+        Value latency(kObjectType);
+
+        for (uint32_t i = 0; i < kLatencyBuckets; ++i) {
+            const uint64_t n = m_latency[i].load(std::memory_order_relaxed);
+            tasks += n;
+            latency.AddMember(StringRef(latency_names[i]), n, allocator);
+        }
+
+        Value out(kObjectType);
+        out.AddMember("cpu",        hwloc_bitmap_first(m_cpuSet), allocator);
+        out.AddMember("tasks",      tasks, allocator);
+        out.AddMember("sleeps",     m_sleeps.load(std::memory_order_relaxed), allocator);
+        out.AddMember("idle",       std::round((1.0 - m_busyTime.load(std::memory_order_relaxed) / elapsed) * 1e4) / 1e4, allocator);
+        out.AddMember("asleep",     std::round(m_sleepTime.load(std::memory_order_relaxed) / elapsed * 1e4) / 1e4, allocator);
+        out.AddMember("latency",    latency, allocator);
+
+        return out;
+    }
 
+    // Only the helper thread writes the statistics, so no atomic read-modify-write is needed
+    static inline void add(std::atomic<uint64_t>& counter, uint64_t value) { counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+
+    static inline uint32_t latency_bucket(uint64_t ns)
+    {
+        uint32_t i = 0;
+        for (uint64_t edge = 256; (i < kLatencyBuckets - 1) && (ns >= edge); edge <<= 2) {
+            ++i;
+        }
+
+        return i;
+    }
+
+    // Returns the time spent sleeping in nanoseconds, 0 if the word changed while spinning
+    uint64_t wait_for_change(std::atomic<uint32_t>& word, uint32_t value, std::atomic<bool>& sleeping)
+    {
+        for (uint32_t total = 0, batch = 1; total < kSpinLimit; total += batch, batch = std::min(batch * 2, kSpinMaxBatch)) {
+            for (uint32_t i = 0; i < batch; ++i) {
+                _mm_pause();
+            }
+
+            if (word.load(std::memory_order_acquire) != value) {
+                return 0;
+            }
+        }
+
+        const uint64_t start = steady_nsecs();
+
+        // Pairs with the seq_cst store + load of the flag on the other side, so the wake-up can't be lost
+        sleeping.store(true, std::memory_order_seq_cst);
+        while (word.load(std::memory_order_seq_cst) == value) {
+            sleep(word, value);
+        }
+        sleeping.store(false, std::memory_order_relaxed);
+
+        return steady_nsecs() - start;
+    }
+
+#   ifdef XMRIG_OS_LINUX
+    static inline void sleep(std::atomic<uint32_t>& word, uint32_t value)   { syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0); }
+    static inline void wake(std::atomic<uint32_t>& word)                    { syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0); }
+#   else
+    inline void sleep(std::atomic<uint32_t>& word, uint32_t value)
+    {
+        uv_mutex_lock(&m_mutex);
+        if (word.load(std::memory_order_seq_cst) == value) {
+            uv_cond_wait(&m_cond, &m_mutex);
+        }
+        uv_mutex_unlock(&m_mutex);
+    }
+
+    inline void wake(std::atomic<uint32_t>&)
+    {
+        uv_mutex_lock(&m_mutex);
+        uv_cond_broadcast(&m_cond);
         uv_mutex_unlock(&m_mutex);
     }
 
     uv_mutex_t m_mutex;
     uv_cond_t m_cond;
+#   endif
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32-bit");
+
+    static std::mutex m_registryMutex;
+    static std::vector<HelperThread*> m_registry;
+
+    // Written by the worker thread
+    std::atomic<uint32_t> m_head{ 0 };
+    std::atomic<bool> m_ownerSleeping{ false };
+    uint64_t m_launchTime[kSlots] = {};
+
+    alignas(16) uint8_t m_tasks[kSlots][128] = {};
+
+    // Written by the helper thread
+    std::atomic<uint32_t> m_tail{ 0 };
+    std::atomic<bool> m_helperSleeping{ false };
+    std::atomic<uint64_t> m_latency[kLatencyBuckets] = {};
+    std::atomic<uint64_t> m_busyTime{ 0 };
+    std::atomic<uint64_t> m_sleepTime{ 0 };
+    std::atomic<uint64_t> m_sleeps{ 0 };
+    uint64_t m_created = 0;
 
-    alignas(16) uint8_t m_tasks[4][128] = {};
-    volatile uint32_t m_numTasks = 0;
     volatile bool m_ready = false;
-    volatile bool m_finished = false;
+    std::atomic<bool> m_finished{ false };
     hwloc_bitmap_t m_cpuSet = {};
     int m_priority = -1;
     bool m_is8MB = false;
@@ -287,15 +810,56 @@ struct HelperThread
 };
 
 
-void benchmark()
+std::mutex HelperThread::m_registryMutex;
+std::vector<HelperThread*> HelperThread::m_registry;
+
+
+const char* tune_key()
+{
+    static const std::string key = []() {
+        hwloc_topology_t topology = Cpu::info()->topology();
+
+#       if HWLOC_API_VERSION >= 0x20000
+        int l3_count = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_L3CACHE);
+#       else
+        const int depth = hwloc_get_cache_type_depth(topology, 3, HWLOC_OBJ_CACHE_UNIFIED);
+        int l3_count = (depth >= 0) ? hwloc_get_nbobjs_by_depth(topology, static_cast<unsigned>(depth)) : 0;
+#       endif
+
+        l3_count = std::max(l3_count, 1);
+
+        char buf[256];
+        snprintf(buf, sizeof(buf), "%s, %dx%zu MB L3, %zu cores", Cpu::info()->brand(), l3_count, (Cpu::info()->L3() / l3_count) >> 20, Cpu::info()->cores());
+
+        return std::string(buf);
+    }();
+
+    return key.c_str();
+}
+
+
+bool benchmark(bool force)
 {
 #if !defined(XMRIG_ARM) && !defined(XMRIG_RISCV)
-    static std::atomic<int> done{ 0 };
-    if (done.exchange(1)) {
-        return;
+    {
+        std::lock_guard<std::mutex> lock(tuneMutex);
+
+        if (!force && !tuned && load_tune()) {
+            tuned = true;
+
+            LOG_VERBOSE("Loaded GhostRider tuning results for \"%s\" from config", tune_key());
+            print_tune();
+        }
+
+        if (tuned && !force) {
+            return false;
+        }
     }
 
-    std::thread t([]() {
+    AlgoTune newDefault[6];
+    AlgoTune new8MB[6];
+
+    std::thread t([&newDefault, &new8MB]() {
         // Try to avoid CPU core 0 because many system threads use it and can interfere
         uint32_t thread_index1 = (Cpu::info()->threads() > 2) ? 2 : 0;
 
@@ -317,38 +881,29 @@ void benchmark()
         VirtualMemory::init(0, N);
         VirtualMemory* memory = new VirtualMemory(N * 8, true, false, false);
 
-        // 2 MB cache per core by default
-        size_t max_scratchpad_size = 1U << 21;
-
-        if ((Cpu::info()->L3() >> 22) > Cpu::info()->cores()) {
-            // At least 1 core can run with 8 MB cache
-            max_scratchpad_size = 1U << 23;
-        }
-        else if ((Cpu::info()->L3() >> 22) >= Cpu::info()->cores()) {
-            // All cores can run with 4 MB cache
-            max_scratchpad_size = 1U << 22;
-        }
-
-        LOG_VERBOSE("Running GhostRider benchmark on logical CPUs %u and %u (max scratchpad size %zu MB, huge pages %s)", thread_index1, thread_index2, max_scratchpad_size >> 20, memory->isHugePages() ? "on" : "off");
+        LOG_VERBOSE("Running GhostRider benchmark on logical CPUs %u and %u (max scratchpad size %zu MB, huge pages %s)", thread_index1, thread_index2, max_scratchpad_size() >> 20, memory->isHugePages() ? "on" : "off");
 
         cryptonight_ctx* ctx[8];
         CnCtx::create(ctx, memory->scratchpad(), N, 8);
 
         const CnHash::AlgoVariant* av = Cpu::info()->hasAES() ? av_hw_aes : av_soft_aes;
 
-        uint8_t buf[80];
+        // CnHash reads "step" inputs back to back
+        uint8_t buf[80 * 8] = {};
         uint8_t hash[32 * 8];
 
         LOG_VERBOSE("%24s |  N  | Hashrate", "Algorithm");
         LOG_VERBOSE("-------------------------|-----|-------------");
 
         for (uint32_t algo = 0; algo < 6; ++algo) {
-            for (uint64_t step : { 1, 2, 4}) {
+            for (uint64_t step : { 1, 2, 4, 8 }) {
                 const size_t cur_scratchpad_size = cn_sizes[algo] * step;
-                if (cur_scratchpad_size > max_scratchpad_size) {
+                if ((step > kMaxStep) || (cur_scratchpad_size > max_scratchpad_size())) {
                     continue;
                 }
 
+                pack_scratchpads(ctx, memory->scratchpad(), 0, step, step, cn_sizes[algo]);
+
                 auto f = CnHash::fn(cn_hash[algo], av[step], Assembly::AUTO);
 
                 double start_time = Chrono::highResolutionMSecs();
@@ -362,7 +917,7 @@ void benchmark()
                         break;
                     }
 
-                    f(buf, sizeof(buf), hash, ctx, 0);
+                    f(buf, 80, hash, ctx, 0);
 
                     const double dt = Chrono::highResolutionMSecs() - t1;
                     if (dt < min_dt) {
@@ -373,16 +928,16 @@ void benchmark()
                 const double hashrate = step * 1e3 / min_dt;
                 LOG_VERBOSE("%24s | %" PRIu64 "x1 | %.2f h/s", cn_names[algo], step, hashrate);
 
-                if (hashrate > tune8MB[algo].hashrate) {
-                    tune8MB[algo].hashrate = hashrate;
-                    tune8MB[algo].step = static_cast<uint32_t>(step);
-                    tune8MB[algo].threads = 1;
+                if (hashrate > new8MB[algo].hashrate) {
+                    new8MB[algo].hashrate = hashrate;
+                    new8MB[algo].step = static_cast<uint32_t>(step);
+                    new8MB[algo].threads = 1;
                 }
 
-                if ((cur_scratchpad_size < (1U << 23)) && (hashrate > tuneDefault[algo].hashrate)) {
-                    tuneDefault[algo].hashrate = hashrate;
-                    tuneDefault[algo].step = static_cast<uint32_t>(step);
-                    tuneDefault[algo].threads = 1;
+                if ((cur_scratchpad_size < (1U << 23)) && (hashrate > newDefault[algo].hashrate)) {
+                    newDefault[algo].hashrate = hashrate;
+                    newDefault[algo].step = static_cast<uint32_t>(step);
+                    newDefault[algo].threads = 1;
                 }
             }
         }
@@ -392,12 +947,16 @@ void benchmark()
         HelperThread* helper = new HelperThread(helper_set, 3, false);
 
         for (uint32_t algo = 0; algo < 6; ++algo) {
-            for (uint64_t step : { 1, 2, 4}) {
+            for (uint64_t step : { 1, 2, 4 }) {
                 const size_t cur_scratchpad_size = cn_sizes[algo] * step * 2;
-                if (cur_scratchpad_size > max_scratchpad_size) {
+                if (cur_scratchpad_size > max_scratchpad_size()) {
                     continue;
                 }
 
+                // Same layout as hash_octa: the helper thread uses the second half of the memory
+                pack_scratchpads(ctx, memory->scratchpad(), 0, step, step, cn_sizes[algo]);
+                pack_scratchpads(ctx, memory->scratchpad() + N * 4, step, step * 2, step, cn_sizes[algo]);
+
                 auto f = CnHash::fn(cn_hash[algo], av[step], Assembly::AUTO);
 
                 double start_time = Chrono::highResolutionMSecs();
@@ -411,8 +970,8 @@ void benchmark()
                         break;
                     }
 
-                    helper->launch_task([&f, &buf, &hash, &ctx, &step]() { f(buf, sizeof(buf), hash + step * 32, ctx + step, 0); });
-                    f(buf, sizeof(buf), hash, ctx, 0);
+                    helper->launch_task([&f, &buf, &hash, &ctx, &step]() { f(buf, 80, hash + step * 32, ctx + step, 0); });
+                    f(buf, 80, hash, ctx, 0);
                     helper->wait();
 
                     const double dt = Chrono::highResolutionMSecs() - t1;
@@ -424,16 +983,16 @@ void benchmark()
                 const double hashrate = step * 2e3 / min_dt * 1.0075;
                 LOG_VERBOSE("%24s | %" PRIu64 "x2 | %.2f h/s", cn_names[algo], step, hashrate);
 
-                if (hashrate > tune8MB[algo].hashrate) {
-                    tune8MB[algo].hashrate = hashrate;
-                    tune8MB[algo].step = static_cast<uint32_t>(step);
-                    tune8MB[algo].threads = 2;
+                if (hashrate > new8MB[algo].hashrate) {
+                    new8MB[algo].hashrate = hashrate;
+                    new8MB[algo].step = static_cast<uint32_t>(step);
+                    new8MB[algo].threads = 2;
                 }
 
-                if ((cur_scratchpad_size < (1U << 23)) && (hashrate > tuneDefault[algo].hashrate)) {
-                    tuneDefault[algo].hashrate = hashrate;
-                    tuneDefault[algo].step = static_cast<uint32_t>(step);
-                    tuneDefault[algo].threads = 2;
+                if ((cur_scratchpad_size < (1U << 23)) && (hashrate > newDefault[algo].hashrate)) {
+                    newDefault[algo].hashrate = hashrate;
+                    newDefault[algo].step = static_cast<uint32_t>(step);
+                    newDefault[algo].threads = 2;
                 }
             }
         }
@@ -446,20 +1005,36 @@ void benchmark()
 
     t.join();
 
-    LOG_VERBOSE("---------------------------------------------");
-    LOG_VERBOSE("|         GhostRider tuning results         |");
-    LOG_VERBOSE("---------------------------------------------");
+    std::lock_guard<std::mutex> lock(tuneMutex);
 
-    for (int algo = 0; algo < 6; ++algo) {
-        LOG_VERBOSE("%24s | %ux%u | %.2f h/s", cn_names[algo], tuneDefault[algo].step, tuneDefault[algo].threads, tuneDefault[algo].hashrate);
-        if ((tune8MB[algo].step != tuneDefault[algo].step) || (tune8MB[algo].threads != tuneDefault[algo].threads)) {
-            LOG_VERBOSE("%24s | %ux%u | %.2f h/s", cn_names[algo], tune8MB[algo].step, tune8MB[algo].threads, tune8MB[algo].hashrate);
-        }
+    for (size_t algo = 0; algo < 6; ++algo) {
+        tuneDefault[algo] = newDefault[algo];
+        tune8MB[algo]     = new8MB[algo];
     }
+
+    reset_live_tune();
+
+    tuned = true;
+    ++tuneVersion;
+
+    print_tune();
+
+    return true;
+#else
+    return false;
 #endif
 }
 
 
+void set_live_tune(bool enable)
+{
+    if ((liveTune.exchange(enable) != enable) && enable) {
+        std::lock_guard<std::mutex> lock(tuneMutex);
+        reset_live_tune();
+    }
+}
+
+
 template <typename func>
 static inline bool findByType(hwloc_obj_t obj, hwloc_obj_type_t type, func lambda)
 {
@@ -553,6 +1128,20 @@ HelperThread* create_helper_thread(int64_t cpu_index, int priority, const std::v
 }
 
 
+rapidjson::Value helpers_to_json(rapidjson::Document& doc)
+{
+    rapidjson::Value out(rapidjson::kArrayType);
+
+    std::lock_guard<std::mutex> lock(HelperThread::m_registryMutex);
+
+    for (const HelperThread* t : HelperThread::m_registry) {
+        out.PushBack(t->toJSON(doc), doc.GetAllocator());
+    }
+
+    return out;
+}
+
+
 void destroy_helper_thread(HelperThread* t)
 {
     delete t;
@@ -586,14 +1175,19 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
     }
 
     const CnHash::AlgoVariant* av = Cpu::info()->hasAES() ? av_hw_aes : av_soft_aes;
-    const AlgoTune* tune = (helper && helper->m_is8MB) ? tune8MB : tuneDefault;
+    const bool is8MB = helper && helper->m_is8MB;
+
+    AlgoTune tune[3];
+    const bool live = select_tune(tune, cn_indices, is8MB, helper != nullptr);
+
+    double cn_time[3] = {};
 
     uint8_t tmp[64 * N];
 
-    if (helper && (tune[cn_indices[0]].threads == 2) && (tune[cn_indices[1]].threads == 2) && (tune[cn_indices[2]].threads == 2)) {
+    if (helper && (tune[0].threads == 2) && (tune[1].threads == 2) && (tune[2].threads == 2)) {
         constexpr size_t n = N / 2;
 
-        helper->launch_task([av, data, size, &ctx_memory, ctx, &cn_indices, &core_indices, &tmp, output, tune]() {
+        helper->launch_task([av, data, size, &ctx_memory, ctx, &cn_indices, &core_indices, &tmp, output, &tune]() {
 #           ifdef _MSC_VER
             constexpr size_t n = N / 2;
 #           endif
@@ -602,30 +1196,12 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
             size_t input_size = size;
 
             for (size_t part = 0; part < 3; ++part) {
-                const AlgoTune& t = tune[cn_indices[part]];
-
-                // Allocate scratchpads
-                {
-                    uint8_t* p = ctx_memory[4];
+                const AlgoTune& t = tune[part];
 
-                    for (size_t i = n, k = 4; i < N; ++i) {
-                        if ((i % t.step) == 0) {
-                            k = 4;
-                            p = ctx_memory[4];
-                        }
-                        else if (p - ctx_memory[k] >= (1 << 21)) {
-                            ++k;
-                            p = ctx_memory[k];
-                        }
-                        ctx[i]->memory = p;
-                        p += cn_sizes[cn_indices[part]];
-                    }
-                }
+                pack_scratchpads(ctx, ctx_memory[n], n, N, t.step, cn_sizes[cn_indices[part]]);
 
                 for (size_t i = 0; i < 5; ++i) {
-                    for (size_t j = n; j < N; ++j) {
-                        core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                    }
+                    core_hash_lanes(core_indices[part * 5 + i], input, input_size, tmp, n, N);
                     input = tmp;
                     input_size = 64;
                 }
@@ -646,39 +1222,27 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
         size_t input_size = size;
 
         for (size_t part = 0; part < 3; ++part) {
-            const AlgoTune& t = tune[cn_indices[part]];
+            const AlgoTune& t = tune[part];
 
-            // Allocate scratchpads
-            {
-                uint8_t* p = ctx_memory[0];
-
-                for (size_t i = 0, k = 0; i < n; ++i) {
-                    if ((i % t.step) == 0) {
-                        k = 0;
-                        p = ctx_memory[0];
-                    }
-                    else if (p - ctx_memory[k] >= (1 << 21)) {
-                        ++k;
-                        p = ctx_memory[k];
-                    }
-                    ctx[i]->memory = p;
-                    p += cn_sizes[cn_indices[part]];
-                }
-            }
+            pack_scratchpads(ctx, ctx_memory[0], 0, n, t.step, cn_sizes[cn_indices[part]]);
 
             for (size_t i = 0; i < 5; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                }
+                core_hash_lanes(core_indices[part * 5 + i], input, input_size, tmp, 0, n);
                 input = tmp;
                 input_size = 64;
             }
 
+            const double t1 = live ? Chrono::highResolutionMSecs() : 0.0;
+
             auto f = CnHash::fn(cn_hash[cn_indices[part]], av[t.step], Assembly::AUTO);
             for (size_t j = 0; j < n; j += t.step) {
                 f(tmp + j * 64, 64, output + j * 32, ctx, 0);
             }
 
+            if (live) {
+                cn_time[part] = Chrono::highResolutionMSecs() - t1;
+            }
+
             for (size_t j = 0; j < n; ++j) {
                 memcpy(tmp + j * 64, output + j * 32, 32);
                 memset(tmp + j * 64 + 32, 0, 32);
@@ -689,44 +1253,14 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
     }
     else {
         for (size_t part = 0; part < 3; ++part) {
-            const AlgoTune& t = tune[cn_indices[part]];
-
-            // Allocate scratchpads
-            {
-                uint8_t* p = ctx_memory[0];
-                const size_t n = N / t.threads;
-
-                // Thread 1
-                for (size_t i = 0, k = 0; i < n; ++i) {
-                    if ((i % t.step) == 0) {
-                        k = 0;
-                        p = ctx_memory[0];
-                    }
-                    else if (p - ctx_memory[k] >= (1 << 21)) {
-                        ++k;
-                        p = ctx_memory[k];
-                    }
-                    ctx[i]->memory = p;
-                    p += cn_sizes[cn_indices[part]];
-                }
-
-                // Thread 2
-                for (size_t i = n, k = 4; i < N; ++i) {
-                    if ((i % t.step) == 0) {
-                        k = 4;
-                        p = ctx_memory[4];
-                    }
-                    else if (p - ctx_memory[k] >= (1 << 21)) {
-                        ++k;
-                        p = ctx_memory[k];
-                    }
-                    ctx[i]->memory = p;
-                    p += cn_sizes[cn_indices[part]];
-                }
-            }
+            const AlgoTune& t = tune[part];
 
             size_t n = N;
 
+            // Thread 2 (if used) gets the second half of the memory
+            pack_scratchpads(ctx, ctx_memory[0], 0, N / t.threads, t.step, cn_sizes[cn_indices[part]]);
+            pack_scratchpads(ctx, ctx_memory[N / t.threads], N / t.threads, N, t.step, cn_sizes[cn_indices[part]]);
+
             if (helper && (t.threads == 2)) {
                 n = N / 2;
 
@@ -735,9 +1269,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
                     size_t input_size = size;
 
                     for (size_t i = 0; i < 5; ++i) {
-                        for (size_t j = n; j < N; ++j) {
-                            core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                        }
+                        core_hash_lanes(core_indices[part * 5 + i], input, input_size, tmp, n, N);
                         input = tmp;
                         input_size = 64;
                     }
@@ -755,13 +1287,13 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
             }
 
             for (size_t i = 0; i < 5; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    core_hash[core_indices[part * 5 + i]](data + j * size, size, tmp + j * 64);
-                }
+                core_hash_lanes(core_indices[part * 5 + i], data, size, tmp, 0, n);
                 data = tmp;
                 size = 64;
             }
 
+            const double t1 = live ? Chrono::highResolutionMSecs() : 0.0;
+
             auto f = CnHash::fn(cn_hash[cn_indices[part]], av[t.step], Assembly::AUTO);
             for (size_t j = 0; j < n; j += t.step) {
                 f(tmp + j * 64, 64, output + j * 32, ctx, 0);
@@ -775,9 +1307,17 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
             if (helper && (t.threads == 2)) {
                 helper->wait();
             }
+
+            if (live) {
+                cn_time[part] = Chrono::highResolutionMSecs() - t1;
+            }
         }
     }
 
+    if (live) {
+        update_tune(cn_indices, tune, cn_time, is8MB, helper != nullptr);
+    }
+
     for (size_t i = 0; i < N; ++i) {
         ctx[i]->memory = ctx_memory[i];
     }
@@ -787,8 +1327,12 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
 #else // XMRIG_FEATURE_HWLOC
 
 
-void benchmark() {}
+bool benchmark(bool) { return false; }
+const char* tune_key() { return Cpu::info()->brand(); }
+void set_live_tune(bool) {}
+static rapidjson::Value table_to_json(rapidjson::Document&) { return rapidjson::Value(rapidjson::kNullType); }
 HelperThread* create_helper_thread(int64_t, int, const std::vector<int64_t>&) { return nullptr; }
+rapidjson::Value helpers_to_json(rapidjson::Document&) { return rapidjson::Value(rapidjson::kArrayType); }
 void destroy_helper_thread(HelperThread*) {}
 
 
@@ -832,28 +1376,10 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
 
     for (size_t part = 0; part < 3; ++part) {
 
-        // Allocate scratchpads
-        {
-            uint8_t* p = ctx_memory[0];
-
-            for (size_t i = 0, k = 0; i < N; ++i) {
-                if ((i % step[cn_indices[part]]) == 0) {
-                    k = 0;
-                    p = ctx_memory[0];
-                }
-                else if (p - ctx_memory[k] >= (1 << 21)) {
-                    ++k;
-                    p = ctx_memory[k];
-                }
-                ctx[i]->memory = p;
-                p += cn_sizes[cn_indices[part]];
-            }
-        }
+        pack_scratchpads(ctx, ctx_memory[0], 0, N, step[cn_indices[part]], cn_sizes[cn_indices[part]]);
 
         for (size_t i = 0; i < 5; ++i) {
-            for (size_t j = 0; j < N; ++j) {
-                core_hash[core_indices[part * 5 + i]](data + j * size, size, tmp + j * 64);
-            }
+            core_hash_lanes(core_indices[part * 5 + i], data, size, tmp, 0, N);
             data = tmp;
             size = 64;
         }
@@ -878,6 +1404,64 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
 #endif // XMRIG_FEATURE_HWLOC
 
 
+void tune_read(const rapidjson::Value& value)
+{
+    rapidjson::Document doc(rapidjson::kObjectType);
+    if (value.IsObject()) {
+        doc.CopyFrom(value, doc.GetAllocator());
+    }
+
+    std::lock_guard<std::mutex> lock(tuneMutex);
+    tuneDoc.Swap(doc);
+}
+
+
+rapidjson::Value tune_to_json(rapidjson::Document& doc)
+{
+    using namespace rapidjson;
+    auto& allocator = doc.GetAllocator();
+
+    std::lock_guard<std::mutex> lock(tuneMutex);
+
+    Value out(tuneDoc, allocator);
+
+    if (tuned) {
+        const auto i = out.FindMember(tune_key());
+        if (i != out.MemberEnd()) {
+            i->value = table_to_json(doc);
+        }
+        else {
+            out.AddMember(Value(tune_key(), allocator), table_to_json(doc), allocator);
+        }
+    }
+
+    return out;
+}
+
+
+rapidjson::Value tune_status(rapidjson::Document& doc)
+{
+    using namespace rapidjson;
+    auto& allocator = doc.GetAllocator();
+
+    std::lock_guard<std::mutex> lock(tuneMutex);
+
+    Value out(kObjectType);
+    out.AddMember("cpu",    Value(tune_key(), allocator), allocator);
+    out.AddMember("tuned",  tuned, allocator);
+    out.AddMember("live",   liveTune.load(), allocator);
+    out.AddMember("table",  tuned ? table_to_json(doc) : Value(kNullType), allocator);
+
+    return out;
+}
+
+
+uint32_t tune_version()
+{
+    return tuneVersion.load();
+}
+
+
 } // namespace ghostrider
 
 
@@ -25,6 +25,9 @@
 #include <vector>
 
 
+#include "3rdparty/rapidjson/fwd.h"
+
+
 struct cryptonight_ctx;
 
 
@@ -38,7 +41,22 @@ namespace ghostrider
 
 struct HelperThread;
 
-void benchmark();
+// Returns true if the tuning table was measured (not loaded from the config)
+bool benchmark(bool force = false);
+
+// Tuning tables are stored in the config keyed by CPU model and L3 topology
+const char* tune_key();
+void tune_read(const rapidjson::Value& value);
+rapidjson::Value tune_to_json(rapidjson::Document& doc);
+rapidjson::Value tune_status(rapidjson::Document& doc);
+uint32_t tune_version();
+
+// Re-calibrate the tuning table from live timings collected in hash_octa
+void set_live_tune(bool enable);
+
+// Per helper thread statistics for the backends API
+rapidjson::Value helpers_to_json(rapidjson::Document& doc);
+
 HelperThread* create_helper_thread(int64_t cpu_index, int priority, const std::vector<int64_t>& affinities);
 void destroy_helper_thread(HelperThread* t);
 void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose = true);
@@ -0,0 +1,51 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_GR_MB_H
+#define XMRIG_GR_MB_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+namespace ghostrider
+{
+
+
+// Hashes 4 (AVX2) or 8 (AVX-512) inputs of the same size stored back to back, writes 64 bytes per lane
+using core_hash_mb_func = void (*)(const uint8_t* data, size_t size, uint8_t* output);
+
+// Largest input size supported by the multi-buffer kernels, longer inputs use the scalar code
+constexpr size_t kMaxMultiBufferSize = 256;
+
+// Returns nullptr if the core hash with this index has no multi-buffer implementation
+core_hash_mb_func core_hash_avx2(uint32_t index);
+core_hash_mb_func core_hash_avx512(uint32_t index);
+
+
+} // namespace ghostrider
+
+
+} // namespace xmrig
+
+#endif // XMRIG_GR_MB_H
@@ -0,0 +1,56 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <immintrin.h>
+#include <cstdint>
+
+
+namespace {
+
+
+// 4 lanes of 64-bit words
+struct V
+{
+    using T = __m256i;
+    static constexpr size_t N = 4;
+
+    static inline T zero()                  { return _mm256_setzero_si256(); }
+    static inline T set1(uint64_t x)        { return _mm256_set1_epi64x(static_cast<long long>(x)); }
+    static inline T load(const uint64_t* p) { return _mm256_load_si256(reinterpret_cast<const T*>(p)); }
+    static inline void store(uint64_t* p, T x) { _mm256_store_si256(reinterpret_cast<T*>(p), x); }
+
+    static inline T add(T a, T b)           { return _mm256_add_epi64(a, b); }
+    static inline T sub(T a, T b)           { return _mm256_sub_epi64(a, b); }
+    static inline T xor_(T a, T b)          { return _mm256_xor_si256(a, b); }
+    static inline T andnot(T a, T b)        { return _mm256_andnot_si256(a, b); }
+    static inline T shl(T x, int n)         { return _mm256_slli_epi64(x, n); }
+    static inline T shr(T x, int n)         { return _mm256_srli_epi64(x, n); }
+    static inline T rol(T x, int n)         { return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n)); }
+};
+
+
+} // namespace
+
+
+#include "ghostrider_mb_impl.h"
+
+
+xmrig::ghostrider::core_hash_mb_func xmrig::ghostrider::core_hash_avx2(uint32_t index)
+{
+    return core_hash_mb(index);
+}
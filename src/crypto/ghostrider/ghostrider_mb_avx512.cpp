@@ -0,0 +1,58 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <immintrin.h>
+#include <cstdint>
+
+
+namespace {
+
+
+// 8 lanes of 64-bit words, rotations and the keccak chi step map to single AVX-512F instructions.
+// Zero-masked forms with a full mask are used where the plain intrinsics pass _mm512_undefined_epi32(),
+// which GCC reports as an uninitialized read.
+struct V
+{
+    using T = __m512i;
+    static constexpr size_t N = 8;
+
+    static inline T zero()                  { return _mm512_setzero_si512(); }
+    static inline T set1(uint64_t x)        { return _mm512_set1_epi64(static_cast<long long>(x)); }
+    static inline T load(const uint64_t* p) { return _mm512_load_si512(p); }
+    static inline void store(uint64_t* p, T x) { _mm512_store_si512(p, x); }
+
+    static inline T add(T a, T b)           { return _mm512_add_epi64(a, b); }
+    static inline T sub(T a, T b)           { return _mm512_sub_epi64(a, b); }
+    static inline T xor_(T a, T b)          { return _mm512_xor_si512(a, b); }
+    static inline T andnot(T a, T b)        { return _mm512_maskz_andnot_epi64(0xFF, a, b); }
+    static inline T shl(T x, int n)         { return _mm512_maskz_slli_epi64(0xFF, x, static_cast<unsigned int>(n)); }
+    static inline T shr(T x, int n)         { return _mm512_maskz_srli_epi64(0xFF, x, static_cast<unsigned int>(n)); }
+    static inline T rol(T x, int n)         { return _mm512_maskz_rolv_epi64(0xFF, x, _mm512_set1_epi64(n)); }
+};
+
+
+} // namespace
+
+
+#include "ghostrider_mb_impl.h"
+
+
+xmrig::ghostrider::core_hash_mb_func xmrig::ghostrider::core_hash_avx512(uint32_t index)
+{
+    return core_hash_mb(index);
+}
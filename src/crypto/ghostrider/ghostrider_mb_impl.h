@@ -0,0 +1,638 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Multi-buffer versions of the GhostRider core hashes that work on 64-bit words: blake512, bmw512, keccak512 and skein512.
+ * Every vector element holds the same state word of a different lane, so the code below is the scalar algorithm with
+ * V operations. This file is included by ghostrider_mb_avx2.cpp and ghostrider_mb_avx512.cpp, each of them defines V
+ * (vector type T, lane count N and the operations) for its instruction set.
+ *
+ * Results must match sph_blake512, sph_bmw512, sph_keccak512 and sph_skein512 bit for bit.
+ */
+
+#include "ghostrider_mb.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace xmrig
+{
+
+
+namespace ghostrider
+{
+
+
+namespace
+{
+
+
+using T = V::T;
+constexpr size_t N = V::N;
+
+
+static inline uint64_t bswap64(uint64_t x)
+{
+    x = ((x & 0x00FF00FF00FF00FFULL) << 8)  | ((x >> 8)  & 0x00FF00FF00FF00FFULL);
+    x = ((x & 0x0000FFFF0000FFFFULL) << 16) | ((x >> 16) & 0x0000FFFF0000FFFFULL);
+    return (x << 32) | (x >> 32);
+}
+
+
+// Padded messages of all lanes, stored word-major so that words[i] can be loaded as one vector
+struct alignas(64) Message
+{
+    uint8_t bytes[N][kMaxMultiBufferSize + 256];
+    uint64_t words[(kMaxMultiBufferSize + 256) / 8][N];
+
+    inline void copy(const uint8_t* data, size_t size, size_t padded_size)
+    {
+        for (size_t j = 0; j < N; ++j) {
+            memcpy(bytes[j], data + j * size, size);
+            memset(bytes[j] + size, 0, padded_size - size);
+        }
+    }
+
+    inline void transpose(size_t padded_size, bool big_endian)
+    {
+        for (size_t i = 0; i < padded_size / 8; ++i) {
+            for (size_t j = 0; j < N; ++j) {
+                uint64_t w;
+                memcpy(&w, bytes[j] + i * 8, 8);
+                words[i][j] = big_endian ? bswap64(w) : w;
+            }
+        }
+    }
+
+    inline T word(size_t i) const { return V::load(words[i]); }
+};
+
+
+static inline void store_output(const T* h, uint8_t* output, bool big_endian)
+{
+    alignas(64) uint64_t tmp[8][N];
+
+    for (size_t i = 0; i < 8; ++i) {
+        V::store(tmp[i], h[i]);
+    }
+
+    for (size_t j = 0; j < N; ++j) {
+        for (size_t i = 0; i < 8; ++i) {
+            const uint64_t w = big_endian ? bswap64(tmp[i][j]) : tmp[i][j];
+            memcpy(output + j * 64 + i * 8, &w, 8);
+        }
+    }
+}
+
+
+static inline T rotr(T x, int n) { return V::rol(x, 64 - n); }
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// BLAKE-512
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const uint64_t blake_iv[8] = {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+    0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL, 0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
+};
+
+static const uint64_t blake_cb[16] = {
+    0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL, 0xA4093822299F31D0ULL, 0x082EFA98EC4E6C89ULL,
+    0x452821E638D01377ULL, 0xBE5466CF34E90C6CULL, 0xC0AC29B7C97C50DDULL, 0x3F84D5B5B5470917ULL,
+    0x9216D5D98979FB1BULL, 0xD1310BA698DFB5ACULL, 0x2FFD72DBD01ADFB7ULL, 0xB8E1AFED6A267E96ULL,
+    0xBA7C9045F12C7F99ULL, 0x24A19947B3916CF7ULL, 0x0801F2E2858EFC16ULL, 0x636920D871574E69ULL
+};
+
+static const uint8_t blake_sigma[10][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+
+static inline void blake_g(const T* m, const uint8_t* s, size_t i, T& a, T& b, T& c, T& d)
+{
+    a = V::add(V::add(a, b), V::xor_(m[s[i]], V::set1(blake_cb[s[i + 1]])));
+    d = rotr(V::xor_(d, a), 32);
+    c = V::add(c, d);
+    b = rotr(V::xor_(b, c), 25);
+    a = V::add(V::add(a, b), V::xor_(m[s[i + 1]], V::set1(blake_cb[s[i]])));
+    d = rotr(V::xor_(d, a), 16);
+    c = V::add(c, d);
+    b = rotr(V::xor_(b, c), 11);
+}
+
+
+static void blake512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    Message msg;
+
+    // 0x80 padding bit, final 0x01 bit and 128-bit big-endian length
+    const size_t blocks      = (size + 17 + 127) / 128;
+    const size_t padded_size = blocks * 128;
+
+    msg.copy(data, size, padded_size);
+
+    for (size_t j = 0; j < N; ++j) {
+        uint8_t* p = msg.bytes[j];
+        const uint64_t bits = bswap64(static_cast<uint64_t>(size) << 3);
+
+        p[size] = 0x80;
+        p[padded_size - 17] |= 0x01;
+        memcpy(p + padded_size - 8, &bits, 8);
+    }
+
+    msg.transpose(padded_size, true);
+
+    T h[8];
+    for (size_t i = 0; i < 8; ++i) {
+        h[i] = V::set1(blake_iv[i]);
+    }
+
+    for (size_t b = 0; b < blocks; ++b) {
+        T m[16];
+        for (size_t i = 0; i < 16; ++i) {
+            m[i] = msg.word(b * 16 + i);
+        }
+
+        // The counter is the number of message bits up to the end of this block, 0 for a block with padding only
+        const uint64_t t0 = (b * 128 < size) ? (std::min(size, (b + 1) * 128) << 3) : 0;
+
+        T v[16];
+        for (size_t i = 0; i < 8; ++i) {
+            v[i] = h[i];
+        }
+
+        v[ 8] = V::set1(blake_cb[0]);
+        v[ 9] = V::set1(blake_cb[1]);
+        v[10] = V::set1(blake_cb[2]);
+        v[11] = V::set1(blake_cb[3]);
+        v[12] = V::set1(t0 ^ blake_cb[4]);
+        v[13] = V::set1(t0 ^ blake_cb[5]);
+        v[14] = V::set1(blake_cb[6]);
+        v[15] = V::set1(blake_cb[7]);
+
+        for (size_t r = 0; r < 16; ++r) {
+            const uint8_t* s = blake_sigma[r % 10];
+
+            blake_g(m, s,  0, v[0], v[4], v[ 8], v[12]);
+            blake_g(m, s,  2, v[1], v[5], v[ 9], v[13]);
+            blake_g(m, s,  4, v[2], v[6], v[10], v[14]);
+            blake_g(m, s,  6, v[3], v[7], v[11], v[15]);
+            blake_g(m, s,  8, v[0], v[5], v[10], v[15]);
+            blake_g(m, s, 10, v[1], v[6], v[11], v[12]);
+            blake_g(m, s, 12, v[2], v[7], v[ 8], v[13]);
+            blake_g(m, s, 14, v[3], v[4], v[ 9], v[14]);
+        }
+
+        for (size_t i = 0; i < 8; ++i) {
+            h[i] = V::xor_(h[i], V::xor_(v[i], v[i + 8]));
+        }
+    }
+
+    store_output(h, output, true);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// BMW-512
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const uint64_t bmw_iv[16] = {
+    0x8081828384858687ULL, 0x88898A8B8C8D8E8FULL, 0x9091929394959697ULL, 0x98999A9B9C9D9E9FULL,
+    0xA0A1A2A3A4A5A6A7ULL, 0xA8A9AAABACADAEAFULL, 0xB0B1B2B3B4B5B6B7ULL, 0xB8B9BABBBCBDBEBFULL,
+    0xC0C1C2C3C4C5C6C7ULL, 0xC8C9CACBCCCDCECFULL, 0xD0D1D2D3D4D5D6D7ULL, 0xD8D9DADBDCDDDEDFULL,
+    0xE0E1E2E3E4E5E6E7ULL, 0xE8E9EAEBECEDEEEFULL, 0xF0F1F2F3F4F5F6F7ULL, 0xF8F9FAFBFCFDFEFFULL
+};
+
+// W[j] = x[i0] +/- x[i1] +/- x[i2] +/- x[i3] +/- x[i4] with x[i] = M[i] ^ H[i]
+static const uint8_t bmw_w[16][5] = {
+    {  5,  7, 10, 13, 14 },
+    {  6,  8, 11, 14, 15 },
+    {  0,  7,  9, 12, 15 },
+    {  0,  1,  8, 10, 13 },
+    {  1,  2,  9, 11, 14 },
+    {  3,  2, 10, 12, 15 },
+    {  4,  0,  3, 11, 13 },
+    {  1,  4,  5, 12, 14 },
+    {  2,  5,  6, 13, 15 },
+    {  0,  3,  6,  7, 14 },
+    {  8,  1,  4,  7, 15 },
+    {  8,  0,  2,  5,  9 },
+    {  1,  3,  6,  9, 10 },
+    {  2,  4,  7, 10, 11 },
+    {  3,  5,  8, 11, 12 },
+    { 12,  4,  6,  9, 13 }
+};
+
+// Bit k set: x[i_k] is subtracted
+static const uint8_t bmw_w_sub[16] = {
+    0x02, 0x12, 0x08, 0x0A, 0x18, 0x0A, 0x0E, 0x1E, 0x16, 0x0A, 0x0E, 0x0E, 0x0C, 0x00, 0x1A, 0x0E
+};
+
+
+static inline T bmw_s(T x, size_t i)
+{
+    switch (i) {
+    case 0:  return V::xor_(V::xor_(V::shr(x, 1), V::shl(x, 3)), V::xor_(V::rol(x,  4), V::rol(x, 37)));
+    case 1:  return V::xor_(V::xor_(V::shr(x, 1), V::shl(x, 2)), V::xor_(V::rol(x, 13), V::rol(x, 43)));
+    case 2:  return V::xor_(V::xor_(V::shr(x, 2), V::shl(x, 1)), V::xor_(V::rol(x, 19), V::rol(x, 53)));
+    case 3:  return V::xor_(V::xor_(V::shr(x, 2), V::shl(x, 2)), V::xor_(V::rol(x, 28), V::rol(x, 59)));
+    case 4:  return V::xor_(V::shr(x, 1), x);
+    default: return V::xor_(V::shr(x, 2), x);
+    }
+}
+
+
+static inline T bmw_add_elt(const T* m, const T* h, size_t j)
+{
+    const T a = V::rol(m[j % 16],        static_cast<int>(j % 16) + 1);
+    const T b = V::rol(m[(j + 3) % 16],  static_cast<int>((j + 3) % 16) + 1);
+    const T c = V::rol(m[(j + 10) % 16], static_cast<int>((j + 10) % 16) + 1);
+
+    return V::xor_(V::add(V::sub(V::add(a, b), c), V::set1((j + 16) * 0x0555555555555555ULL)), h[(j + 7) % 16]);
+}
+
+
+static void bmw_compress(const T* m, const T* h, T* dh)
+{
+    static const int r[7] = { 5, 11, 27, 32, 37, 43, 53 };
+
+    T x[16];
+    T q[32];
+
+    for (size_t i = 0; i < 16; ++i) {
+        x[i] = V::xor_(m[i], h[i]);
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        T w = x[bmw_w[i][0]];
+
+        for (size_t k = 1; k < 5; ++k) {
+            const T y = x[bmw_w[i][k]];
+            w = (bmw_w_sub[i] & (1 << k)) ? V::sub(w, y) : V::add(w, y);
+        }
+
+        q[i] = V::add(bmw_s(w, i % 5), h[(i + 1) % 16]);
+    }
+
+    for (size_t i = 16; i < 18; ++i) {
+        T s = bmw_add_elt(m, h, i - 16);
+
+        for (size_t k = 0; k < 16; ++k) {
+            s = V::add(s, bmw_s(q[i - 16 + k], (k + 1) % 4));
+        }
+
+        q[i] = s;
+    }
+
+    for (size_t i = 18; i < 32; ++i) {
+        T s = bmw_add_elt(m, h, i - 16);
+
+        for (size_t k = 0; k < 14; k += 2) {
+            s = V::add(s, V::add(q[i - 16 + k], V::rol(q[i - 15 + k], r[k / 2])));
+        }
+
+        q[i] = V::add(s, V::add(bmw_s(q[i - 2], 4), bmw_s(q[i - 1], 5)));
+    }
+
+    T xl = q[16];
+    for (size_t i = 17; i < 24; ++i) {
+        xl = V::xor_(xl, q[i]);
+    }
+
+    T xh = xl;
+    for (size_t i = 24; i < 32; ++i) {
+        xh = V::xor_(xh, q[i]);
+    }
+
+    dh[0] = V::add(V::xor_(V::xor_(V::shl(xh,  5), V::shr(q[16], 5)), m[0]), V::xor_(V::xor_(xl, q[24]), q[0]));
+    dh[1] = V::add(V::xor_(V::xor_(V::shr(xh,  7), V::shl(q[17], 8)), m[1]), V::xor_(V::xor_(xl, q[25]), q[1]));
+    dh[2] = V::add(V::xor_(V::xor_(V::shr(xh,  5), V::shl(q[18], 5)), m[2]), V::xor_(V::xor_(xl, q[26]), q[2]));
+    dh[3] = V::add(V::xor_(V::xor_(V::shr(xh,  1), V::shl(q[19], 5)), m[3]), V::xor_(V::xor_(xl, q[27]), q[3]));
+    dh[4] = V::add(V::xor_(V::xor_(V::shr(xh,  3), q[20]),            m[4]), V::xor_(V::xor_(xl, q[28]), q[4]));
+    dh[5] = V::add(V::xor_(V::xor_(V::shl(xh,  6), V::shr(q[21], 6)), m[5]), V::xor_(V::xor_(xl, q[29]), q[5]));
+    dh[6] = V::add(V::xor_(V::xor_(V::shr(xh,  4), V::shl(q[22], 6)), m[6]), V::xor_(V::xor_(xl, q[30]), q[6]));
+    dh[7] = V::add(V::xor_(V::xor_(V::shr(xh, 11), V::shl(q[23], 2)), m[7]), V::xor_(V::xor_(xl, q[31]), q[7]));
+
+    dh[ 8] = V::add(V::add(V::rol(dh[4],  9), V::xor_(V::xor_(xh, q[24]), m[ 8])), V::xor_(V::xor_(V::shl(xl, 8), q[23]), q[ 8]));
+    dh[ 9] = V::add(V::add(V::rol(dh[5], 10), V::xor_(V::xor_(xh, q[25]), m[ 9])), V::xor_(V::xor_(V::shr(xl, 6), q[16]), q[ 9]));
+    dh[10] = V::add(V::add(V::rol(dh[6], 11), V::xor_(V::xor_(xh, q[26]), m[10])), V::xor_(V::xor_(V::shl(xl, 6), q[17]), q[10]));
+    dh[11] = V::add(V::add(V::rol(dh[7], 12), V::xor_(V::xor_(xh, q[27]), m[11])), V::xor_(V::xor_(V::shl(xl, 4), q[18]), q[11]));
+    dh[12] = V::add(V::add(V::rol(dh[0], 13), V::xor_(V::xor_(xh, q[28]), m[12])), V::xor_(V::xor_(V::shr(xl, 3), q[19]), q[12]));
+    dh[13] = V::add(V::add(V::rol(dh[1], 14), V::xor_(V::xor_(xh, q[29]), m[13])), V::xor_(V::xor_(V::shr(xl, 4), q[20]), q[13]));
+    dh[14] = V::add(V::add(V::rol(dh[2], 15), V::xor_(V::xor_(xh, q[30]), m[14])), V::xor_(V::xor_(V::shr(xl, 7), q[21]), q[14]));
+    dh[15] = V::add(V::add(V::rol(dh[3], 16), V::xor_(V::xor_(xh, q[31]), m[15])), V::xor_(V::xor_(V::shr(xl, 2), q[22]), q[15]));
+}
+
+
+static void bmw512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    Message msg;
+
+    // 0x80 padding bit and 64-bit little-endian length
+    const size_t blocks      = (size + 9 + 127) / 128;
+    const size_t padded_size = blocks * 128;
+
+    msg.copy(data, size, padded_size);
+
+    for (size_t j = 0; j < N; ++j) {
+        const uint64_t bits = static_cast<uint64_t>(size) << 3;
+
+        msg.bytes[j][size] = 0x80;
+        memcpy(msg.bytes[j] + padded_size - 8, &bits, 8);
+    }
+
+    msg.transpose(padded_size, false);
+
+    T h[16];
+    T m[16];
+
+    for (size_t i = 0; i < 16; ++i) {
+        h[i] = V::set1(bmw_iv[i]);
+    }
+
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t i = 0; i < 16; ++i) {
+            m[i] = msg.word(b * 16 + i);
+        }
+
+        T dh[16];
+        bmw_compress(m, h, dh);
+
+        for (size_t i = 0; i < 16; ++i) {
+            h[i] = dh[i];
+        }
+    }
+
+    // Final compression of the chaining value with the constant 0xaaaaaaaaaaaaaaa0 + i as the chaining input
+    T f[16];
+    for (size_t i = 0; i < 16; ++i) {
+        f[i] = V::set1(0xAAAAAAAAAAAAAAA0ULL + i);
+    }
+
+    T dh[16];
+    bmw_compress(h, f, dh);
+
+    store_output(dh + 8, output, false);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Keccak-512
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const uint64_t keccak_rc[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+    0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+static const int keccak_rho[25] = {
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14
+};
+
+
+static void keccak_f1600(T* a)
+{
+    for (size_t round = 0; round < 24; ++round) {
+        T c[5];
+        for (size_t x = 0; x < 5; ++x) {
+            c[x] = V::xor_(V::xor_(V::xor_(a[x], a[x + 5]), V::xor_(a[x + 10], a[x + 15])), a[x + 20]);
+        }
+
+        for (size_t x = 0; x < 5; ++x) {
+            const T d = V::xor_(c[(x + 4) % 5], V::rol(c[(x + 1) % 5], 1));
+            for (size_t y = 0; y < 25; y += 5) {
+                a[x + y] = V::xor_(a[x + y], d);
+            }
+        }
+
+        // rho and pi: B[y, 2x + 3y] = rot(A[x, y])
+        T b[25];
+        for (size_t x = 0; x < 5; ++x) {
+            for (size_t y = 0; y < 5; ++y) {
+                b[y + 5 * ((2 * x + 3 * y) % 5)] = V::rol(a[x + 5 * y], keccak_rho[x + 5 * y]);
+            }
+        }
+
+        for (size_t y = 0; y < 25; y += 5) {
+            for (size_t x = 0; x < 5; ++x) {
+                a[x + y] = V::xor_(b[x + y], V::andnot(b[(x + 1) % 5 + y], b[(x + 2) % 5 + y]));
+            }
+        }
+
+        a[0] = V::xor_(a[0], V::set1(keccak_rc[round]));
+    }
+}
+
+
+static void keccak512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    constexpr size_t rate = 72;
+
+    Message msg;
+
+    // Original Keccak padding (0x01 ... 0x80), not the SHA-3 one
+    const size_t blocks      = size / rate + 1;
+    const size_t padded_size = blocks * rate;
+
+    msg.copy(data, size, padded_size);
+
+    for (size_t j = 0; j < N; ++j) {
+        msg.bytes[j][size] = 0x01;
+        msg.bytes[j][padded_size - 1] |= 0x80;
+    }
+
+    msg.transpose(padded_size, false);
+
+    T a[25];
+    for (size_t i = 0; i < 25; ++i) {
+        a[i] = V::zero();
+    }
+
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t i = 0; i < rate / 8; ++i) {
+            a[i] = V::xor_(a[i], msg.word(b * (rate / 8) + i));
+        }
+
+        keccak_f1600(a);
+    }
+
+    store_output(a, output, false);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Skein-512-512
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const uint64_t skein_iv[8] = {
+    0x4903ADFF749C51CEULL, 0x0D95DE399746DF03ULL, 0x8FD1934127C79BCEULL, 0x9A255629FF352CB1ULL,
+    0x5DB62599DF6CA7B0ULL, 0xEABE394CA9D5C3F4ULL, 0x991112C71A75B523ULL, 0xAE18A40B660FCC33ULL
+};
+
+static const int skein_rot[8][4] = {
+    { 46, 36, 19, 37 },
+    { 33, 27, 14, 42 },
+    { 17, 49, 36, 39 },
+    { 44,  9, 54, 56 },
+    { 39, 30, 34, 24 },
+    { 13, 50, 10, 17 },
+    { 25, 29, 39, 43 },
+    {  8, 35, 56, 22 }
+};
+
+// Word order of the 4 MIX8 steps of a Threefish-512 round group
+static const uint8_t skein_perm[4][8] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7 },
+    { 2, 1, 4, 7, 6, 5, 0, 3 },
+    { 4, 1, 6, 3, 0, 5, 2, 7 },
+    { 6, 1, 0, 7, 2, 5, 4, 3 }
+};
+
+
+// One UBI block: h = Threefish(h, tweak, m) ^ m
+static void skein_ubi(T* h, const T* m, uint64_t t0, uint64_t t1)
+{
+    const uint64_t t[3] = { t0, t1, t0 ^ t1 };
+
+    T k[9];
+    k[8] = V::set1(0x1BD11BDAA9FC1A22ULL);
+    for (size_t i = 0; i < 8; ++i) {
+        k[i] = h[i];
+        k[8] = V::xor_(k[8], h[i]);
+    }
+
+    T p[8];
+    for (size_t i = 0; i < 8; ++i) {
+        p[i] = m[i];
+    }
+
+    for (size_t s = 0; s <= 18; ++s) {
+        for (size_t i = 0; i < 8; ++i) {
+            p[i] = V::add(p[i], k[(s + i) % 9]);
+        }
+
+        p[5] = V::add(p[5], V::set1(t[s % 3]));
+        p[6] = V::add(p[6], V::set1(t[(s + 1) % 3]));
+        p[7] = V::add(p[7], V::set1(s));
+
+        if (s == 18) {
+            break;
+        }
+
+        for (size_t r = 0; r < 4; ++r) {
+            const uint8_t* w = skein_perm[r];
+            const int* rc    = skein_rot[(s & 1) * 4 + r];
+
+            for (size_t i = 0; i < 4; ++i) {
+                T& x0 = p[w[i * 2]];
+                T& x1 = p[w[i * 2 + 1]];
+
+                x0 = V::add(x0, x1);
+                x1 = V::xor_(V::rol(x1, rc[i]), x0);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        h[i] = V::xor_(m[i], p[i]);
+    }
+}
+
+
+static void skein512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    constexpr uint64_t first  = 1ULL << 62;
+    constexpr uint64_t final  = 1ULL << 63;
+    constexpr uint64_t msg    = 48ULL << 56;
+    constexpr uint64_t out    = 63ULL << 56;
+
+    Message m;
+
+    const size_t blocks      = (size + 63) / 64;
+    const size_t padded_size = blocks * 64;
+
+    m.copy(data, size, padded_size);
+    m.transpose(padded_size, false);
+
+    T h[8];
+    for (size_t i = 0; i < 8; ++i) {
+        h[i] = V::set1(skein_iv[i]);
+    }
+
+    for (size_t b = 0; b < blocks; ++b) {
+        T w[8];
+        for (size_t i = 0; i < 8; ++i) {
+            w[i] = m.word(b * 8 + i);
+        }
+
+        const bool last = (b + 1 == blocks);
+        const uint64_t t0 = last ? size : (b + 1) * 64;
+        const uint64_t t1 = msg | (b == 0 ? first : 0) | (last ? final : 0);
+
+        skein_ubi(h, w, t0, t1);
+    }
+
+    T zero[8];
+    for (size_t i = 0; i < 8; ++i) {
+        zero[i] = V::zero();
+    }
+
+    skein_ubi(h, zero, 8, out | first | final);
+
+    store_output(h, output, false);
+}
+
+
+static core_hash_mb_func core_hash_mb(uint32_t index)
+{
+    switch (index) {
+    case 0:  return blake512;
+    case 1:  return bmw512;
+    case 4:  return keccak512;
+    case 5:  return skein512;
+    default: return nullptr;
+    }
+}
+
+
+} // namespace
+
+
+} // namespace ghostrider
+
+
+} // namespace xmrig
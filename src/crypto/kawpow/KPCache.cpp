@@ -19,7 +19,9 @@
 
 #include <cinttypes>
 #include <algorithm>
+#include <mutex>
 #include <thread>
+#include <uv.h>
 
 #include "crypto/kawpow/KPCache.h"
 #include "3rdparty/libethash/data_sizes.h"
@@ -27,15 +29,114 @@
 #include "3rdparty/libethash/ethash.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/tools/Baton.h"
 #include "base/tools/Chrono.h"
 #include "crypto/common/VirtualMemory.h"
+#include "crypto/kawpow/KPHash.h"
 
 
 namespace xmrig {
 
 
-std::mutex KPCache::s_cacheMutex;
-KPCache KPCache::s_cache;
+static constexpr size_t kSlots                  = 3;
+static constexpr uint32_t kPrefetchDistance     = 100;  // blocks before the epoch boundary
+
+
+// Built caches, read with std::atomic_load() and replaced with std::atomic_store() under buildMutex
+static KPCache::Ptr slots[kSlots];
+static std::mutex buildMutex;
+
+// Epochs queued for a background build, accessed only from the main loop thread
+static std::vector<uint32_t> queued;
+
+
+class KPCacheBaton : public Baton<uv_work_t>
+{
+public:
+    inline KPCacheBaton(uint32_t epoch) : epoch(epoch) {}
+
+    const uint32_t epoch;
+};
+
+
+static KPCache::Ptr find(uint32_t epoch)
+{
+    for (auto &slot : slots) {
+        auto cache = std::atomic_load(&slot);
+        if (cache && cache->epoch() == epoch) {
+            return cache;
+        }
+    }
+
+    return {};
+}
+
+
+// Must be called with buildMutex held
+static KPCache::Ptr build(uint32_t epoch)
+{
+    auto cache = find(epoch);
+    if (cache) {
+        return cache;
+    }
+
+    auto next = std::make_shared<KPCache>();
+    if (!next->init(epoch)) {
+        return {};
+    }
+
+    // Replace the cache of the epoch most distant from the new one, readers still using it keep it alive
+    size_t index      = 0;
+    uint32_t distance = 0;
+
+    for (size_t i = 0; i < kSlots; ++i) {
+        auto slot = std::atomic_load(&slots[i]);
+        if (!slot) {
+            index = i;
+            break;
+        }
+
+        const uint32_t d = slot->epoch() > epoch ? slot->epoch() - epoch : epoch - slot->epoch();
+        if (d > distance) {
+            distance = d;
+            index    = i;
+        }
+    }
+
+    cache = next;
+    std::atomic_store(&slots[index], cache);
+
+    return cache;
+}
+
+
+static void queue(uint32_t epoch)
+{
+    if (KPCache::cache_size(epoch) == 0 || find(epoch) || std::find(queued.begin(), queued.end(), epoch) != queued.end()) {
+        return;
+    }
+
+    queued.emplace_back(epoch);
+
+    auto baton = new KPCacheBaton(epoch);
+
+    uv_queue_work(uv_default_loop(), &baton->req,
+        [](uv_work_t *req) {
+            auto baton = static_cast<KPCacheBaton*>(req->data);
+
+            std::lock_guard<std::mutex> lock(buildMutex);
+
+            build(baton->epoch);
+        },
+        [](uv_work_t *req, int) {
+            auto baton = static_cast<KPCacheBaton*>(req->data);
+
+            queued.erase(std::remove(queued.begin(), queued.end(), baton->epoch), queued.end());
+
+            delete baton;
+        }
+    );
+}
 
 
 KPCache::KPCache()
@@ -112,6 +213,31 @@ bool KPCache::init(uint32_t epoch)
 }
 
 
+KPCache::Ptr KPCache::get(uint32_t epoch)
+{
+    auto cache = find(epoch);
+    if (cache || cache_size(epoch) == 0) {
+        return cache;
+    }
+
+    std::lock_guard<std::mutex> lock(buildMutex);
+
+    return build(epoch);
+}
+
+
+void KPCache::prefetch(uint64_t height)
+{
+    const uint32_t epoch = static_cast<uint32_t>(height / KPHash::EPOCH_LENGTH);
+
+    queue(epoch);
+
+    if (height % KPHash::EPOCH_LENGTH >= KPHash::EPOCH_LENGTH - kPrefetchDistance) {
+        queue(epoch + 1);
+    }
+}
+
+
 void* KPCache::data() const
 {
     return m_memory ? m_memory->raw() : nullptr;
@@ -21,7 +21,7 @@
 
 
 #include "base/tools/Object.h"
-#include <mutex>
+#include <memory>
 #include <vector>
 
 
@@ -32,6 +32,11 @@ namespace xmrig
 class VirtualMemory;
 
 
+// Light cache and L1 DAG cache of one epoch, immutable once built.
+//
+// Caches are shared between GPU runners and CPU-side share verification through get(), which takes no lock
+// when the epoch is already built. prefetch() builds the cache of the next epoch in the background shortly
+// before the epoch boundary, so the first jobs of the new epoch do not wait for it.
 class KPCache
 {
 public:
@@ -39,6 +44,8 @@ public:
     static constexpr size_t l1_cache_num_items = l1_cache_size / sizeof(uint32_t);
     static constexpr uint32_t num_dataset_parents = 512;
 
+    using Ptr = std::shared_ptr<const KPCache>;
+
     XMRIG_DISABLE_COPY_MOVE(KPCache)
 
     KPCache();
@@ -57,8 +64,11 @@ public:
 
     static void calculate_fast_mod_data(uint32_t divisor, uint32_t &reciprocal, uint32_t &increment, uint32_t& shift);
 
-    static std::mutex s_cacheMutex;
-    static KPCache s_cache;
+    // Returns the cache for "epoch", builds it first if needed, nullptr if the epoch is out of range
+    static Ptr get(uint32_t epoch);
+
+    // Starts building the caches needed for "height" (and the next epoch, if close to its start) in the background
+    static void prefetch(uint64_t height);
 
 private:
     VirtualMemory* m_memory = nullptr;
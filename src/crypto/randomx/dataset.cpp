@@ -95,15 +95,17 @@ namespace randomx {
 
 		argon2_ctx_mem(&context, Argon2_d, cache->memory, RandomX_CurrentConfig.ArgonMemory * 1024);
 
+		initCachePrograms(cache, key, keySize);
+	}
+
+	void initCachePrograms(randomx_cache* cache, const void* key, size_t keySize) {
 		randomx::Blake2Generator gen(key, keySize);
 		for (uint32_t i = 0; i < RandomX_CurrentConfig.CacheAccesses; ++i) {
 			randomx::generateSuperscalar(cache->programs[i], gen);
 		}
 	}
 
-	void initCacheCompile(randomx_cache* cache, const void* key, size_t keySize) {
-		initCache(cache, key, keySize);
-
+	static void compileCache(randomx_cache* cache) {
 #		ifdef XMRIG_SECURE_JIT
 		cache->jit->enableWriting();
 #		endif
@@ -117,6 +119,16 @@ namespace randomx {
 #		endif
 	}
 
+	void initCacheCompile(randomx_cache* cache, const void* key, size_t keySize) {
+		initCache(cache, key, keySize);
+		compileCache(cache);
+	}
+
+	void initCacheProgramsCompile(randomx_cache* cache, const void* key, size_t keySize) {
+		initCachePrograms(cache, key, keySize);
+		compileCache(cache);
+	}
+
 	constexpr uint64_t superscalarMul0 = 6364136223846793005ULL;
 	constexpr uint64_t superscalarAdd1 = 9298411001130361340ULL;
 	constexpr uint64_t superscalarAdd2 = 12065312585734608966ULL;
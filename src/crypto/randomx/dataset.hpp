@@ -45,6 +45,7 @@ struct randomx_cache {
 	uint8_t* memory = nullptr;
 	randomx::JitCompiler* jit = nullptr;
 	randomx::CacheInitializeFunc* initialize;
+	randomx::CacheInitializeFunc* restore;
 	randomx::DatasetInitFunc* datasetInit;
 	randomx::SuperscalarProgram programs[RANDOMX_CACHE_MAX_ACCESSES];
 
@@ -72,6 +73,8 @@ namespace randomx {
 
 	void initCache(randomx_cache*, const void*, size_t);
 	void initCacheCompile(randomx_cache*, const void*, size_t);
+	void initCachePrograms(randomx_cache*, const void*, size_t);
+	void initCacheProgramsCompile(randomx_cache*, const void*, size_t);
 	void initDatasetItem(randomx_cache* cache, uint8_t* out, uint64_t blockNumber);
 	void initDataset(randomx_cache* cache, uint8_t* dataset, uint32_t startBlock, uint32_t endBlock);
 }
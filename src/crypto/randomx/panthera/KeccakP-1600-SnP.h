@@ -34,8 +34,16 @@ void KeccakP1600_OverwriteBytes(void *state, const unsigned char *data, unsigned
 void KeccakP1600_OverwriteWithZeroes(void *state, unsigned int byteCount);
 void KeccakP1600_Permute_Nrounds(void *state, unsigned int nrounds);
 void KeccakP1600_Permute_12rounds(void *state);
+void KeccakP1600_Permute_12rounds_ref(void *state);
+void KeccakP1600_Permute_12rounds_opt64(void *state);
+#if defined(XMRIG_FEATURE_AVX2)
+void KeccakP1600_Permute_12rounds_bmi2(void *state);
+#endif
 void KeccakP1600_Permute_24rounds(void *state);
 void KeccakP1600_ExtractBytes(const void *state, unsigned char *data, unsigned int offset, unsigned int length);
 void KeccakP1600_ExtractAndAddBytes(const void *state, const unsigned char *input, unsigned char *output, unsigned int offset, unsigned int length);
 
+/* Backend used by KeccakP1600_Permute_12rounds(), selected at run time (see xmrig::Rx::init). */
+extern void (*KeccakP1600_Permute_12rounds_impl)(void *state);
+
 #endif
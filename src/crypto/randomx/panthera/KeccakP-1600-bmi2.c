@@ -0,0 +1,20 @@
+/*
+Implementation by the Keccak Team, namely, Guido Bertoni, Joan Daemen,
+Michaël Peeters, Gilles Van Assche and Ronny Van Keer,
+hereby denoted as "the implementer".
+
+For more information, feedback or questions, please refer to our website:
+https://keccak.team/
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+
+---
+
+KeccakP-1600-opt64.c compiled with -mbmi -mbmi2: chi uses ANDN without
+lane complementing and rho uses RORX.
+*/
+
+#define KeccakP1600_opt64_Permute_12rounds KeccakP1600_Permute_12rounds_bmi2
+#include "KeccakP-1600-opt64.c"
@@ -0,0 +1,234 @@
+/*
+Implementation by the Keccak Team, namely, Guido Bertoni, Joan Daemen,
+Michaël Peeters, Gilles Van Assche and Ronny Van Keer,
+hereby denoted as "the implementer".
+
+For more information, feedback or questions, please refer to our website:
+https://keccak.team/
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+
+---
+
+Fully unrolled 64-bit implementation of Keccak-p[1600] reduced to 12 rounds,
+the only permutation used by KangarooTwelve. The state layout is the same as
+in KeccakP-1600-reference.c, so this function can be swapped in through
+KeccakP1600_Permute_12rounds_impl at run time.
+
+Without BMI1 the "lane complementing" transform is used: 6 lanes are kept
+inverted for the duration of the permutation so that chi needs a single NOT
+per plane instead of five. With BMI1 (KeccakP-1600-bmi2.c builds this file
+with -mbmi -mbmi2) the plain chi maps directly onto ANDN and RORX.
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "brg_endian.h"
+#include "KeccakP-1600-SnP.h"
+
+#ifndef KeccakP1600_opt64_Permute_12rounds
+#define KeccakP1600_opt64_Permute_12rounds KeccakP1600_Permute_12rounds_opt64
+#endif
+
+#if defined(__BMI__)
+#define KeccakP1600_opt64_complementing 0
+#else
+#define KeccakP1600_opt64_complementing 1
+#endif
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#define ROL64(a, offset) _rotl64(a, offset)
+#else
+#define ROL64(a, offset) ((((uint64_t)(a)) << (offset)) ^ (((uint64_t)(a)) >> (64 - (offset))))
+#endif
+
+static const uint64_t KeccakP1600_opt64_RoundConstants[12] =
+{
+    0x000000008000808bULL,
+    0x800000000000008bULL,
+    0x8000000000008089ULL,
+    0x8000000000008003ULL,
+    0x8000000000008002ULL,
+    0x8000000000000080ULL,
+    0x000000000000800aULL,
+    0x800000008000000aULL,
+    0x8000000080008081ULL,
+    0x8000000000008080ULL,
+    0x0000000080000001ULL,
+    0x8000000080008008ULL,
+};
+
+#define declareABCDE \
+    uint64_t Aba, Abe, Abi, Abo, Abu; \
+    uint64_t Aga, Age, Agi, Ago, Agu; \
+    uint64_t Aka, Ake, Aki, Ako, Aku; \
+    uint64_t Ama, Ame, Ami, Amo, Amu; \
+    uint64_t Asa, Ase, Asi, Aso, Asu; \
+    uint64_t Bba, Bbe, Bbi, Bbo, Bbu; \
+    uint64_t Bga, Bge, Bgi, Bgo, Bgu; \
+    uint64_t Bka, Bke, Bki, Bko, Bku; \
+    uint64_t Bma, Bme, Bmi, Bmo, Bmu; \
+    uint64_t Bsa, Bse, Bsi, Bso, Bsu; \
+    uint64_t Ca, Ce, Ci, Co, Cu; \
+    uint64_t Da, De, Di, Do, Du; \
+    uint64_t Eba, Ebe, Ebi, Ebo, Ebu; \
+    uint64_t Ega, Ege, Egi, Ego, Egu; \
+    uint64_t Eka, Eke, Eki, Eko, Eku; \
+    uint64_t Ema, Eme, Emi, Emo, Emu; \
+    uint64_t Esa, Ese, Esi, Eso, Esu;
+
+#define prepareTheta(A) \
+    Ca = A##ba^A##ga^A##ka^A##ma^A##sa; \
+    Ce = A##be^A##ge^A##ke^A##me^A##se; \
+    Ci = A##bi^A##gi^A##ki^A##mi^A##si; \
+    Co = A##bo^A##go^A##ko^A##mo^A##so; \
+    Cu = A##bu^A##gu^A##ku^A##mu^A##su;
+
+#define computeD \
+    Da = Cu^ROL64(Ce, 1); \
+    De = Ca^ROL64(Ci, 1); \
+    Di = Ce^ROL64(Co, 1); \
+    Do = Ci^ROL64(Cu, 1); \
+    Du = Co^ROL64(Ca, 1);
+
+#if KeccakP1600_opt64_complementing
+
+/* Lanes Abe, Abi, Ago, Aki, Ami and Asa are stored complemented. */
+#define chiPlaneB(E) \
+    E##ba =   Bba ^(  Bbe |  Bbi ); \
+    E##be =   Bbe ^((~Bbi)|  Bbo ); \
+    E##bi =   Bbi ^(  Bbo &  Bbu ); \
+    E##bo =   Bbo ^(  Bbu |  Bba ); \
+    E##bu =   Bbu ^(  Bba &  Bbe );
+
+#define chiPlaneG(E) \
+    E##ga =   Bga ^(  Bge |  Bgi ); \
+    E##ge =   Bge ^(  Bgi &  Bgo ); \
+    E##gi =   Bgi ^(  Bgo |(~Bgu)); \
+    E##go =   Bgo ^(  Bgu |  Bga ); \
+    E##gu =   Bgu ^(  Bga &  Bge );
+
+#define chiPlaneK(E) \
+    E##ka =   Bka ^(  Bke |  Bki ); \
+    E##ke =   Bke ^(  Bki &  Bko ); \
+    E##ki =   Bki ^((~Bko)&  Bku ); \
+    E##ko = (~Bko)^(  Bku |  Bka ); \
+    E##ku =   Bku ^(  Bka &  Bke );
+
+#define chiPlaneM(E) \
+    E##ma =   Bma ^(  Bme &  Bmi ); \
+    E##me =   Bme ^(  Bmi |  Bmo ); \
+    E##mi =   Bmi ^((~Bmo)|  Bmu ); \
+    E##mo = (~Bmo)^(  Bmu &  Bma ); \
+    E##mu =   Bmu ^(  Bma |  Bme );
+
+#define chiPlaneS(E) \
+    E##sa =   Bsa ^((~Bse)&  Bsi ); \
+    E##se = (~Bse)^(  Bsi |  Bso ); \
+    E##si =   Bsi ^(  Bso &  Bsu ); \
+    E##so =   Bso ^(  Bsu |  Bsa ); \
+    E##su =   Bsu ^(  Bsa &  Bse );
+
+#else
+
+#define chiPlane(E, p) \
+    E##p##a = B##p##a ^ ((~B##p##e) & B##p##i); \
+    E##p##e = B##p##e ^ ((~B##p##i) & B##p##o); \
+    E##p##i = B##p##i ^ ((~B##p##o) & B##p##u); \
+    E##p##o = B##p##o ^ ((~B##p##u) & B##p##a); \
+    E##p##u = B##p##u ^ ((~B##p##a) & B##p##e);
+
+#define chiPlaneB(E) chiPlane(E, b)
+#define chiPlaneG(E) chiPlane(E, g)
+#define chiPlaneK(E) chiPlane(E, k)
+#define chiPlaneM(E) chiPlane(E, m)
+#define chiPlaneS(E) chiPlane(E, s)
+
+#endif
+
+/* One round from state A into state E: theta, rho, pi, chi and iota. */
+#define thetaRhoPiChiIota(i, A, E) \
+    prepareTheta(A) \
+    computeD \
+    \
+    Bba = A##ba^Da; \
+    Bbe = ROL64(A##ge^De, 44); \
+    Bbi = ROL64(A##ki^Di, 43); \
+    Bbo = ROL64(A##mo^Do, 21); \
+    Bbu = ROL64(A##su^Du, 14); \
+    chiPlaneB(E) \
+    E##ba ^= KeccakP1600_opt64_RoundConstants[i]; \
+    \
+    Bga = ROL64(A##bo^Do, 28); \
+    Bge = ROL64(A##gu^Du, 20); \
+    Bgi = ROL64(A##ka^Da, 3); \
+    Bgo = ROL64(A##me^De, 45); \
+    Bgu = ROL64(A##si^Di, 61); \
+    chiPlaneG(E) \
+    \
+    Bka = ROL64(A##be^De, 1); \
+    Bke = ROL64(A##gi^Di, 6); \
+    Bki = ROL64(A##ko^Do, 25); \
+    Bko = ROL64(A##mu^Du, 8); \
+    Bku = ROL64(A##sa^Da, 18); \
+    chiPlaneK(E) \
+    \
+    Bma = ROL64(A##bu^Du, 27); \
+    Bme = ROL64(A##ga^Da, 36); \
+    Bmi = ROL64(A##ke^De, 10); \
+    Bmo = ROL64(A##mi^Di, 15); \
+    Bmu = ROL64(A##so^Do, 56); \
+    chiPlaneM(E) \
+    \
+    Bsa = ROL64(A##bi^Di, 62); \
+    Bse = ROL64(A##go^Do, 55); \
+    Bsi = ROL64(A##ku^Du, 39); \
+    Bso = ROL64(A##ma^Da, 41); \
+    Bsu = ROL64(A##se^De, 2); \
+    chiPlaneS(E)
+
+#define copyFromState(A, state) \
+    A##ba = state[ 0]; A##be = state[ 1]; A##bi = state[ 2]; A##bo = state[ 3]; A##bu = state[ 4]; \
+    A##ga = state[ 5]; A##ge = state[ 6]; A##gi = state[ 7]; A##go = state[ 8]; A##gu = state[ 9]; \
+    A##ka = state[10]; A##ke = state[11]; A##ki = state[12]; A##ko = state[13]; A##ku = state[14]; \
+    A##ma = state[15]; A##me = state[16]; A##mi = state[17]; A##mo = state[18]; A##mu = state[19]; \
+    A##sa = state[20]; A##se = state[21]; A##si = state[22]; A##so = state[23]; A##su = state[24];
+
+#define copyToState(state, A) \
+    state[ 0] = A##ba; state[ 1] = A##be; state[ 2] = A##bi; state[ 3] = A##bo; state[ 4] = A##bu; \
+    state[ 5] = A##ga; state[ 6] = A##ge; state[ 7] = A##gi; state[ 8] = A##go; state[ 9] = A##gu; \
+    state[10] = A##ka; state[11] = A##ke; state[12] = A##ki; state[13] = A##ko; state[14] = A##ku; \
+    state[15] = A##ma; state[16] = A##me; state[17] = A##mi; state[18] = A##mo; state[19] = A##mu; \
+    state[20] = A##sa; state[21] = A##se; state[22] = A##si; state[23] = A##so; state[24] = A##su;
+
+#define complementLanes(A) \
+    A##be = ~A##be; A##bi = ~A##bi; A##go = ~A##go; A##ki = ~A##ki; A##mi = ~A##mi; A##sa = ~A##sa;
+
+void KeccakP1600_opt64_Permute_12rounds(void *state)
+{
+#if (PLATFORM_BYTE_ORDER == IS_LITTLE_ENDIAN)
+    uint64_t *stateAsLanes = (uint64_t *) state;
+    unsigned int i;
+    declareABCDE
+
+    copyFromState(A, stateAsLanes)
+#   if KeccakP1600_opt64_complementing
+    complementLanes(A)
+#   endif
+
+    for (i = 0; i < 12; i += 2) {
+        thetaRhoPiChiIota(i,     A, E)
+        thetaRhoPiChiIota(i + 1, E, A)
+    }
+
+#   if KeccakP1600_opt64_complementing
+    complementLanes(A)
+#   endif
+    copyToState(stateAsLanes, A)
+#else
+    KeccakP1600_Permute_12rounds_ref(state);
+#endif
+}
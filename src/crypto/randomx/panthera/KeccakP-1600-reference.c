@@ -24,6 +24,7 @@ Please refer to LowLevel.build for the exact list of other files it must be comb
 #include <stdlib.h>
 #include <string.h>
 #include "brg_endian.h"
+#include "KeccakP-1600-SnP.h"
 #ifdef KeccakReference
 #include "displayIntermediateValues.h"
 #endif
@@ -159,7 +160,18 @@ void KeccakP1600_AddBytes(void *state, const unsigned char *data, unsigned int o
 
     assert(offset < 200);
     assert(offset+length <= 200);
-    for(i=0; i<length; i++)
+#if (PLATFORM_BYTE_ORDER == IS_LITTLE_ENDIAN)
+    for(i=0; i+8<=length; i+=8) {
+        tKeccakLane lane, value;
+        memcpy(&lane, (unsigned char *)state+offset+i, 8);
+        memcpy(&value, data+i, 8);
+        lane ^= value;
+        memcpy((unsigned char *)state+offset+i, &lane, 8);
+    }
+#else
+    i = 0;
+#endif
+    for(; i<length; i++)
         ((unsigned char *)state)[offset+i] ^= data[i];
 }
 
@@ -211,7 +223,18 @@ void KeccakP1600_Permute_Nrounds(void *state, unsigned int nrounds)
 #endif
 }
 
+#if (PLATFORM_BYTE_ORDER == IS_LITTLE_ENDIAN)
+void (*KeccakP1600_Permute_12rounds_impl)(void *state) = KeccakP1600_Permute_12rounds_opt64;
+#else
+void (*KeccakP1600_Permute_12rounds_impl)(void *state) = KeccakP1600_Permute_12rounds_ref;
+#endif
+
 void KeccakP1600_Permute_12rounds(void *state)
+{
+    KeccakP1600_Permute_12rounds_impl(state);
+}
+
+void KeccakP1600_Permute_12rounds_ref(void *state)
 {
 #if (PLATFORM_BYTE_ORDER != IS_LITTLE_ENDIAN)
     tKeccakLane stateAsWords[1600/64];
@@ -48,8 +48,9 @@
  * extra instruction prefixes for pwxform (which we make more use of).  While
  * no slowdown from the prefixes is generally observed on AMD CPUs supporting
  * XOP, some slowdown is sometimes observed on Intel CPUs with AVX.
+ * The per-ISA builds (YESPOWER_ISA_FN) are chosen at runtime, so they skip the note.
  */
-#if !defined(_MSC_VER)
+#if !defined(_MSC_VER) && !defined(YESPOWER_ISA_FN)
 #ifdef __XOP__
 #warning "Note: XOP is enabled.  That's great."
 #elif defined(__AVX__)
@@ -86,6 +87,8 @@
 #include <emmintrin.h>
 #ifdef __XOP__
 #include <x86intrin.h>
+#elif defined(__AVX512VL__)
+#include <immintrin.h>
 #endif
 #elif defined(__SSE__)
 #include <xmmintrin.h>
@@ -182,6 +185,9 @@ static inline void salsa20_simd_unshuffle(const salsa20_blk_t *Bin,
 #ifdef __XOP__
 #define ARX(out, in1, in2, s) \
 	out = _mm_xor_si128(out, _mm_roti_epi32(_mm_add_epi32(in1, in2), s));
+#elif defined(__AVX512VL__)
+#define ARX(out, in1, in2, s) \
+	out = _mm_xor_si128(out, _mm_rol_epi32(_mm_add_epi32(in1, in2), s));
 #else
 #define ARX(out, in1, in2, s) { \
 	__m128i tmp = _mm_add_epi32(in1, in2); \
@@ -1026,6 +1032,19 @@ static void smix(uint8_t *B, size_t r, uint32_t N,
 #include "yespower-opt.c"
 #undef smix
 
+/*
+ * This file is compiled once with the default flags (SSE2 on x86-64) and once
+ * per extra instruction set from yespower-avx.c, yespower-avx2.c and
+ * yespower-avx512vl.c, which only define YESPOWER_ISA_FN and include it.
+ * The public API below is built only in the default pass and dispatches to
+ * the implementation chosen with yespower_select_impl_by_name().
+ */
+#ifdef YESPOWER_ISA_FN
+#define yespower_isa YESPOWER_ISA_FN
+#else
+#define yespower_isa yespower_default
+#endif
+
 /**
  * yespower(local, src, srclen, params, dst):
  * Compute yespower(src[0 .. srclen - 1], N, r), to be checked for "< target".
@@ -1034,7 +1053,7 @@ static void smix(uint8_t *B, size_t r, uint32_t N,
  *
  * Return 0 on success; or -1 on error.
  */
-int yespower(yespower_local_t *local,
+int yespower_isa(yespower_local_t *local,
     const uint8_t *src, size_t srclen,
     const yespower_params_t *params,
     yespower_binary_t *dst)
@@ -1127,6 +1146,71 @@ fail:
 	return -1;
 }
 
+#ifndef YESPOWER_ISA_FN
+#if defined(__x86_64__) || defined(_M_AMD64)
+extern int yespower_avx(yespower_local_t *local,
+    const uint8_t *src, size_t srclen,
+    const yespower_params_t *params, yespower_binary_t *dst);
+#ifdef XMRIG_FEATURE_AVX2
+extern int yespower_avx2(yespower_local_t *local,
+    const uint8_t *src, size_t srclen,
+    const yespower_params_t *params, yespower_binary_t *dst);
+extern int yespower_avx512vl(yespower_local_t *local,
+    const uint8_t *src, size_t srclen,
+    const yespower_params_t *params, yespower_binary_t *dst);
+#endif
+#endif
+
+typedef int (*yespower_fn_t)(yespower_local_t *local,
+    const uint8_t *src, size_t srclen,
+    const yespower_params_t *params, yespower_binary_t *dst);
+
+static const struct {
+	const char *name;
+	yespower_fn_t fn;
+} yespower_impls[] = {
+#if defined(__x86_64__) || defined(_M_AMD64)
+	{ "SSE2",      yespower_default },
+	{ "AVX",       yespower_avx },
+#ifdef XMRIG_FEATURE_AVX2
+	{ "AVX2",      yespower_avx2 },
+	{ "AVX-512VL", yespower_avx512vl },
+#endif
+#else
+	{ "default",   yespower_default },
+#endif
+};
+
+static yespower_fn_t yespower_impl = yespower_default;
+static const char *yespower_impl_name = NULL;
+
+int yespower_select_impl_by_name(const char *name)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(yespower_impls) / sizeof(yespower_impls[0]); i++) {
+		if (strcmp(yespower_impls[i].name, name) == 0) {
+			yespower_impl = yespower_impls[i].fn;
+			yespower_impl_name = yespower_impls[i].name;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+const char *yespower_get_impl_name(void)
+{
+	return yespower_impl_name ? yespower_impl_name : yespower_impls[0].name;
+}
+
+int yespower(yespower_local_t *local,
+    const uint8_t *src, size_t srclen,
+    const yespower_params_t *params, yespower_binary_t *dst)
+{
+	return yespower_impl(local, src, srclen, params, dst);
+}
+
 /**
  * yespower_tls(src, srclen, params, dst):
  * Compute yespower(src[0 .. srclen - 1], N, r), to be checked for "< target".
@@ -1158,4 +1242,39 @@ int yespower_free_local(yespower_local_t *local)
 {
 	return free_region(local);
 }
+
+int yespower_init_local_region(yespower_local_t *local,
+    void *mem, size_t size)
+{
+	if ((uintptr_t)mem & 63) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	local->base = NULL;
+	local->base_size = 0;
+	local->aligned = mem;
+	local->aligned_size = mem ? size : 0;
+	return 0;
+}
+
+size_t yespower_local_size(const yespower_params_t *params)
+{
+	size_t B_size = (size_t)128 * params->r;
+
+	if ((params->version != YESPOWER_0_5 &&
+	    params->version != YESPOWER_1_0) ||
+	    params->N < 1024 || params->N > 512 * 1024 ||
+	    params->r < 8 || params->r > 32 ||
+	    (params->N & (params->N - 1)) != 0)
+		return 0;
+
+	if (params->version == YESPOWER_0_5)
+		return B_size + B_size * params->N + B_size * 2 +
+		    2 * Swidth_to_Sbytes1(Swidth_0_5);
+
+	return B_size + B_size * params->N + B_size + 64 +
+	    3 * Swidth_to_Sbytes1(Swidth_1_0);
+}
+#endif /* !YESPOWER_ISA_FN */
 #endif
@@ -95,6 +95,25 @@ extern int yespower_init_local(yespower_local_t *local);
  */
 extern int yespower_free_local(yespower_local_t *local);
 
+/**
+ * yespower_init_local_region(local, mem, size):
+ * Initialize the thread-local (RAM) data structure to use caller-owned memory
+ * of size bytes at mem, which must be 64-byte aligned.  yespower() will not
+ * allocate as long as size is at least yespower_local_size(params), and
+ * yespower_free_local() leaves mem untouched.
+ *
+ * Return 0 on success; or -1 on error.
+ */
+extern int yespower_init_local_region(yespower_local_t *local,
+    void *mem, size_t size);
+
+/**
+ * yespower_local_size(params):
+ * Return the number of bytes of RAM yespower() needs for params, or 0 if
+ * params are invalid.
+ */
+extern size_t yespower_local_size(const yespower_params_t *params);
+
 /**
  * yespower(local, src, srclen, params, dst):
  * Compute yespower(src[0 .. srclen - 1], N, r), to be checked for "< target".
@@ -123,6 +142,24 @@ extern int yespower(yespower_local_t *local,
 extern int yespower_tls(const uint8_t *src, size_t srclen,
     const yespower_params_t *params, yespower_binary_t *dst);
 
+/**
+ * yespower_select_impl_by_name(name):
+ * Select the instruction set specific implementation used by yespower() and
+ * yespower_tls().  On x86-64 name is one of "SSE2", "AVX", "AVX2" or
+ * "AVX-512VL"; other platforms only have "default".
+ *
+ * Return 0 on success; or -1 if name is unknown.
+ *
+ * Not MT-safe, call it before any hashing starts.
+ */
+extern int yespower_select_impl_by_name(const char *name);
+
+/**
+ * yespower_get_impl_name():
+ * Return the name of the currently selected implementation.
+ */
+extern const char *yespower_get_impl_name(void);
+
 #ifdef __cplusplus
 }
 #endif
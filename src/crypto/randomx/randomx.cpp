@@ -435,11 +435,21 @@ alignas(64) RandomX_ConfigurationBase RandomX_CurrentConfig;
 
 static std::mutex vm_pool_mutex;
 
-int rx_yespower_k12(void *out, size_t outlen, const void *in, size_t inlen)
+static const yespower_params_t rx_yespower_params = { YESPOWER_1_0, 2048, 8, NULL, 0 };
+
+int rx_yespower_k12(void *out, size_t outlen, const void *in, size_t inlen, void *scratch)
 {
 	rx_blake2b_wrapper::run(out, outlen, in, inlen);
-	yespower_params_t params = { YESPOWER_1_0, 2048, 8, NULL };
-	if (yespower_tls((const uint8_t *)out, outlen, &params, (yespower_binary_t *)out)) return -1;
+	{
+		PROFILE_SCOPE(RandomX_Yespower);
+		if (scratch) {
+			yespower_local_t local;
+			yespower_init_local_region(&local, scratch, randomx_yespower_size());
+			if (yespower(&local, (const uint8_t *)out, outlen, &rx_yespower_params, (yespower_binary_t *)out)) return -1;
+		}
+		else if (yespower_tls((const uint8_t *)out, outlen, &rx_yespower_params, (yespower_binary_t *)out)) return -1;
+	}
+	PROFILE_SCOPE(RandomX_K12);
 	return KangarooTwelve((const unsigned char *)out, outlen, (unsigned char *)out, 32, 0, 0);
 }
 
@@ -458,6 +468,7 @@ extern "C" {
 				case RANDOMX_FLAG_DEFAULT:
 					cache->jit          = nullptr;
 					cache->initialize   = &randomx::initCache;
+					cache->restore      = &randomx::initCachePrograms;
 					cache->datasetInit  = &randomx::initDataset;
 					cache->memory       = memory;
 					break;
@@ -465,6 +476,7 @@ extern "C" {
 				case RANDOMX_FLAG_JIT:
 					cache->jit          = new randomx::JitCompiler(false, true);
 					cache->initialize   = &randomx::initCacheCompile;
+					cache->restore      = &randomx::initCacheProgramsCompile;
 					cache->datasetInit  = nullptr;
 					cache->memory       = memory;
 					break;
@@ -489,6 +501,21 @@ extern "C" {
 		cache->initialize(cache, key, keySize);
 	}
 
+	void randomx_restore_cache(randomx_cache *cache, const void *key, size_t keySize) {
+		assert(cache != nullptr);
+		assert(keySize == 0 || key != nullptr);
+		cache->restore(cache, key, keySize);
+	}
+
+	void *randomx_get_cache_memory(randomx_cache *cache) {
+		assert(cache != nullptr);
+		return cache->memory;
+	}
+
+	unsigned long randomx_cache_memory_size() {
+		return RandomX_CurrentConfig.ArgonMemory * 1024;
+	}
+
 	void randomx_release_cache(randomx_cache* cache) {
 		delete cache->jit;
 		delete cache;
@@ -650,7 +677,7 @@ extern "C" {
 		assert(output != nullptr);
 		alignas(16) uint64_t tempHash[8];
                 switch (algo) {
-                    case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), input, inputSize); break;
+                    case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), input, inputSize, nullptr); break;
 		    default: rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), input, inputSize);
 		}
 		machine->initScratchpad(&tempHash);
@@ -663,15 +690,15 @@ extern "C" {
 		machine->getFinalResult(output);
 	}
 
-	void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize, const xmrig::Algorithm algo) {
+	void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize, const xmrig::Algorithm algo, void *yespower) {
                 switch (algo) {
-                    case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), input, inputSize); break;
+                    case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), input, inputSize, yespower); break;
 		    default: rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), input, inputSize);
 		}
 		machine->initScratchpad(tempHash);
 	}
 
-	void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output, const xmrig::Algorithm algo) {
+	void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output, const xmrig::Algorithm algo, void *yespower) {
 		PROFILE_SCOPE(RandomX_hash);
 
 		machine->resetRoundingMode();
@@ -683,10 +710,14 @@ extern "C" {
 
 		// Finish current hash and fill the scratchpad for the next hash at the same time
                 switch (algo) {
-                    case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), nextInput, nextInputSize); break;
+                    case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), nextInput, nextInputSize, yespower); break;
 		    default: rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), nextInput, nextInputSize);
 		}
 		machine->hashAndFill(output, tempHash);
 	}
 
+	size_t randomx_yespower_size() {
+		return yespower_local_size(&rx_yespower_params);
+	}
+
 }
@@ -212,6 +212,31 @@ RANDOMX_EXPORT randomx_cache *randomx_create_cache(randomx_flags flags, uint8_t
 */
 RANDOMX_EXPORT void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize);
 
+/**
+ * Finishes initialization of a cache whose memory already holds the Argon2 output
+ * for the key (for example loaded from disk). Only SuperscalarHash is generated.
+ *
+ * @param cache is a pointer to a previously allocated randomx_cache structure. Must not be NULL.
+ * @param key is a pointer to memory which contains the key value. Must not be NULL.
+ * @param keySize is the number of bytes of the key.
+*/
+RANDOMX_EXPORT void randomx_restore_cache(randomx_cache *cache, const void *key, size_t keySize);
+
+/**
+ * Returns a pointer to the internal memory buffer of the cache structure. The size
+ * of the internal memory buffer is randomx_cache_memory_size().
+ *
+ * @param cache is a pointer to a previously allocated randomx_cache structure. Must not be NULL.
+ *
+ * @return Pointer to the internal memory buffer of the cache structure.
+*/
+RANDOMX_EXPORT void *randomx_get_cache_memory(randomx_cache *cache);
+
+/**
+ * @return The number of bytes of cache memory used by the current configuration.
+*/
+RANDOMX_EXPORT unsigned long randomx_cache_memory_size();
+
 /**
  * Releases all memory occupied by the randomx_cache structure.
  *
@@ -329,8 +354,20 @@ RANDOMX_EXPORT void randomx_destroy_vm(randomx_vm *machine);
 */
 RANDOMX_EXPORT void randomx_calculate_hash(randomx_vm *machine, const void *input, size_t inputSize, void *output, const xmrig::Algorithm algo);
 
-RANDOMX_EXPORT void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize, const xmrig::Algorithm algo);
-RANDOMX_EXPORT void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output, const xmrig::Algorithm algo);
+/**
+ * Pipelined variant of randomx_calculate_hash for mining loops.
+ *
+ * @param yespower is optional worker-owned memory of at least randomx_yespower_size()
+ *        bytes used by the Panthera (RX_XLA) yespower pre-hash. When NULL a
+ *        thread-local allocation is used instead.
+*/
+RANDOMX_EXPORT void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize, const xmrig::Algorithm algo, void *yespower = nullptr);
+RANDOMX_EXPORT void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output, const xmrig::Algorithm algo, void *yespower = nullptr);
+
+/**
+ * @return the size of the yespower scratch region needed by the Panthera pre-hash.
+*/
+RANDOMX_EXPORT size_t randomx_yespower_size();
 
 #if defined(__cplusplus)
 }
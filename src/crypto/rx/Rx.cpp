@@ -33,14 +33,18 @@
 #endif
 
 
+#include <atomic>
+
+
 namespace xmrig {
 
 
 class RxPrivate;
 
 
-static bool osInitialized   = false;
-static RxPrivate *d_ptr     = nullptr;
+static bool osInitialized       = false;
+static RxPrivate *d_ptr         = nullptr;
+static std::atomic<uint32_t> lightThreads{ 0 };
 
 
 class RxPrivate
@@ -61,12 +65,30 @@ xmrig::HugePagesInfo xmrig::Rx::hugePages()
 }
 
 
+xmrig::RxCache *xmrig::Rx::cache(const Job &job, uint32_t nodeId)
+{
+    return d_ptr->queue.cache(job, nodeId);
+}
+
+
 xmrig::RxDataset *xmrig::Rx::dataset(const Job &job, uint32_t nodeId)
 {
     return d_ptr->queue.dataset(job, nodeId);
 }
 
 
+uint32_t xmrig::Rx::lightFallbackThreads()
+{
+    return lightThreads;
+}
+
+
+void xmrig::Rx::addLightHashes(uint64_t count)
+{
+    d_ptr->queue.addLightHashes(count);
+}
+
+
 void xmrig::Rx::destroy()
 {
 #   ifdef XMRIG_FEATURE_MSR
@@ -85,11 +107,25 @@ void xmrig::Rx::init(IRxListener *listener)
 }
 
 
+void xmrig::Rx::prepare(const Job &job, const RxConfig &config, const CpuConfig &cpu)
+{
+    if (!config.isPrepareNextDataset() || job.algorithm().family() != Algorithm::RANDOM_X || job.nextSeed().empty() || job.nextSeed() == job.seed()) {
+        return;
+    }
+
+    d_ptr->queue.prepare(RxSeed(job.algorithm(), job.nextSeed()), config.prepareNextDatasetThreads(), cpu.isHugePages(), config.isOneGbPages(), config.mode());
+}
+
+
 #include "crypto/randomx/blake2/blake2.h"
 #if defined(XMRIG_FEATURE_AVX2)
 #include "crypto/randomx/blake2/avx2/blake2b.h"
 #endif
 
+extern "C" {
+#include "crypto/randomx/panthera/KeccakP-1600-SnP.h"
+}
+
 
 void (*rx_blake2b_compress)(blake2b_state* S, const uint8_t * block) = rx_blake2b_compress_integer;
 int (*rx_blake2b)(void* out, size_t outlen, const void* in, size_t inlen) = rx_blake2b_default;
@@ -155,6 +191,10 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         if (Cpu::info()->has(ICpuInfo::FLAG_AVX2)) {
             rx_blake2b = blake2b_avx2;
         }
+
+        if (Cpu::info()->hasBMI2()) {
+            KeccakP1600_Permute_12rounds_impl = KeccakP1600_Permute_12rounds_bmi2;
+        }
 #       endif
 
         osInitialized = true;
@@ -164,7 +204,12 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         return true;
     }
 
-    d_ptr->queue.enqueue(seed, config.nodeset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
+    const auto nodeset      = config.nodeset();
+    const uint32_t threads  = config.threads(cpu.limit());
+    const uint32_t light    = (nodeset.empty() && config.mode() != RxConfig::LightMode) ? std::min(config.lightFallbackThreads(), threads - 1) : 0;
+    lightThreads            = light;
+
+    d_ptr->queue.enqueue(seed, nodeset, threads - light, cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority(), config);
 
     return false;
 }
@@ -38,6 +38,7 @@ class CpuConfig;
 class CpuThread;
 class IRxListener;
 class Job;
+class RxCache;
 class RxConfig;
 class RxDataset;
 
@@ -46,9 +47,13 @@ class Rx
 {
 public:
     static HugePagesInfo hugePages();
+    static RxCache *cache(const Job &job, uint32_t nodeId);
     static RxDataset *dataset(const Job &job, uint32_t nodeId);
+    static uint32_t lightFallbackThreads();
+    static void addLightHashes(uint64_t count);
     static void destroy();
     static void init(IRxListener *listener);
+    static void prepare(const Job &job, const RxConfig &config, const CpuConfig &cpu);
     template<typename T> static bool init(const T &seed, const RxConfig &config, const CpuConfig &cpu);
     template<typename T> static bool isReady(const T &seed);
 
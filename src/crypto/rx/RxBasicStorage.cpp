@@ -24,9 +24,16 @@
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxDatasetFile.h"
 #include "crypto/rx/RxSeed.h"
 
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
 namespace xmrig {
 
 
@@ -38,40 +45,152 @@ class RxBasicStoragePrivate
 public:
     XMRIG_DISABLE_COPY_MOVE(RxBasicStoragePrivate)
 
-    inline RxBasicStoragePrivate() = default;
-    inline ~RxBasicStoragePrivate() { deleteDataset(); }
+    inline RxBasicStoragePrivate(const RxConfig &config) :
+        m_maxDatasets(config.maxDatasets()),
+        m_maxFileSize(config.datasetFileMaxSize() * oneMiB),
+        m_maxMemory(config.maxDatasetsMemory() * oneMiB),
+        m_filePath(config.datasetFilePath())
+    {}
+
+    inline ~RxBasicStoragePrivate()
+    {
+        for (auto &entry : m_entries) {
+            delete entry.dataset;
+        }
+
+        delete m_next.dataset;
+    }
+
+    inline RxDataset *dataset() const           { return m_entries.empty() ? nullptr : m_entries.front().dataset; }
+
+
+    inline bool isAllocated() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return dataset() && dataset()->cache() && dataset()->cache()->get();
+    }
+
+
+    inline bool hasDataset() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return dataset() != nullptr;
+    }
+
+
+    inline RxCache *cache(const Job &job) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto &entry : m_entries) {
+            if ((entry.ready || entry.cacheReady) && entry.seed == job) {
+                return entry.dataset->cache();
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    inline RxDataset *dataset(const Job &job) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto &entry : m_entries) {
+            if (entry.ready && entry.seed == job) {
+                return entry.dataset;
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    inline HugePagesInfo hugePages() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        HugePagesInfo pages;
+
+        for (const auto &entry : m_entries) {
+            if (entry.dataset) {
+                pages += entry.dataset->hugePages();
+            }
+        }
 
-    inline bool isReady(const Job &job) const   { return m_ready && m_seed == job; }
-    inline RxDataset *dataset() const           { return m_dataset; }
-    inline void deleteDataset()                 { delete m_dataset; m_dataset = nullptr; }
+        if (m_next.dataset) {
+            pages += m_next.dataset->hugePages();
+        }
+
+        return pages;
+    }
 
 
-    inline void setSeed(const RxSeed &seed)
+    // Moves the dataset for the seed to the front of the list, reusing a resident or prepared one if possible.
+    // Returns false if the seed is already resident and no initialization is required.
+    inline bool setSeed(const RxSeed &seed)
     {
-        m_ready = false;
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [&seed](const Entry &entry) { return entry.ready && entry.seed == seed; });
+        if (it != m_entries.end()) {
+            std::rotate(m_entries.begin(), it, it + 1);
+            RxAlgo::apply(seed.algorithm());
+
+            LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (resident)"), Tags::randomx());
+
+            return false;
+        }
 
-        if (m_seed.algorithm() != seed.algorithm()) {
+        if (m_next.ready && m_next.seed == seed) {
+            m_entries.insert(m_entries.begin(), m_next);
+            m_next = Entry();
             RxAlgo::apply(seed.algorithm());
+
+            LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (prepared)"), Tags::randomx());
+
+            return false;
+        }
+
+        // An older seed of the same algorithm is never needed again, replace it first, otherwise the least recently used one.
+        it = std::find_if(m_entries.begin(), m_entries.end(), [&seed](const Entry &entry) { return entry.seed.algorithm() == seed.algorithm(); });
+        if (it == m_entries.end() && !m_entries.empty() && !canAllocate()) {
+            it = m_entries.end() - 1;
+        }
+
+        if (it != m_entries.end()) {
+            std::rotate(m_entries.begin(), it, it + 1);
+        }
+        else {
+            m_entries.insert(m_entries.begin(), Entry());
         }
 
-        m_seed = seed;
+        auto &entry = m_entries.front();
+        entry.ready      = false;
+        entry.cacheReady = false;
+        entry.unsaved    = false;
+        entry.seed  = seed;
+
+        RxAlgo::apply(seed.algorithm());
+
+        return true;
     }
 
 
     inline bool createDataset(bool hugePages, bool oneGbPages, RxConfig::Mode mode)
     {
-        const uint64_t ts = Chrono::steadyMSecs();
+        auto dataset = allocate(hugePages, oneGbPages, mode);
 
-        m_dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0);
-        if (!m_dataset->cache()->get()) {
-            deleteDataset();
+        std::lock_guard<std::mutex> lock(m_mutex);
 
-            LOG_INFO("%s" RED_BOLD("failed to allocate RandomX memory") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+        if (!dataset) {
+            m_entries.erase(m_entries.begin());
 
             return false;
         }
 
-        printAllocStatus(ts);
+        m_entries.front().dataset = dataset;
 
         return true;
     }
@@ -81,19 +200,252 @@ public:
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+        // The prepare thread can modify the list, so only the front entry's contents are used outside the lock.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto dataset      = m_entries.front().dataset;
+        const auto seed   = m_entries.front().seed;
+        lock.unlock();
+
+        if (load(dataset, seed)) {
+            setReady(true);
+
+            return;
+        }
+
+        // Light mode fallback can start hashing with the cache while the dataset is being initialized
+        if (dataset->get() && dataset->cache()->get()) {
+            dataset->cache()->init(seed.data());
 
-        if (m_ready) {
+            lock.lock();
+            m_entries.front().cacheReady = true;
+            lock.unlock();
+        }
+
+        const bool ready = dataset->init(seed.data(), threads, priority);
+
+        lock.lock();
+        m_entries.front().ready   = ready;
+        m_entries.front().unsaved = ready && !m_filePath.isEmpty();
+        lock.unlock();
+
+        if (ready) {
             LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
         }
     }
 
 
+    // Writes a freshly initialized dataset to the file, called from the background thread after the dataset is already in use.
+    inline void save(const RxSeed &seed, const std::atomic<bool> &cancel)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [&seed](const Entry &entry) { return entry.ready && entry.unsaved && entry.seed == seed; });
+        if (it == m_entries.end()) {
+            return;
+        }
+
+        auto dataset = it->dataset;
+
+        lock.unlock();
+
+        if (!write(dataset, seed, &cancel)) {
+            return;
+        }
+
+        lock.lock();
+
+        for (auto &entry : m_entries) {
+            if (entry.dataset == dataset && entry.seed == seed) {
+                entry.unsaved = false;
+            }
+        }
+    }
+
+
+    // Builds the dataset for the next seed of the current algorithm into a separate slot, the current dataset stays in use.
+    // Runs on its own low priority thread and gives up as soon as the cancel flag is set.
+    inline void prepare(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, const std::atomic<bool> &cancel)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Dataset initialization depends on the global RandomX configuration, so only the active algorithm can be prepared.
+        if (m_entries.empty() || !m_entries.front().ready || m_entries.front().seed.algorithm() != seed.algorithm()) {
+            return;
+        }
+
+        if ((m_next.ready && m_next.seed == seed) || std::any_of(m_entries.begin(), m_entries.end(), [&seed](const Entry &entry) { return entry.ready && entry.seed == seed; })) {
+            return;
+        }
+
+        if (!m_next.dataset) {
+            auto it = std::find_if(m_entries.begin() + 1, m_entries.end(), [&seed](const Entry &entry) { return entry.seed.algorithm() == seed.algorithm(); });
+            if (it == m_entries.end() && !canAllocate(1)) {
+                if (m_entries.size() == 1) {
+                    LOG_WARN("%s" YELLOW_BOLD("not enough memory budget to prepare the next dataset"), Tags::randomx());
+
+                    return;
+                }
+
+                it = m_entries.end() - 1;
+            }
+
+            if (it != m_entries.end()) {
+                m_next = *it;
+                m_entries.erase(it);
+            }
+        }
+
+        m_next.ready      = false;
+        m_next.cacheReady = false;
+        m_next.seed       = seed;
+
+        auto dataset = m_next.dataset;
+
+        lock.unlock();
+
+        if (!dataset) {
+            dataset = allocate(hugePages, oneGbPages, mode);
+
+            lock.lock();
+            if (!dataset) {
+                m_next = Entry();
+
+                return;
+            }
+
+            m_next.dataset = dataset;
+            lock.unlock();
+        }
+
+        const uint64_t ts = Chrono::steadyMSecs();
+        const bool ready  = load(dataset, seed) || dataset->init(seed.data(), threads, 0, &cancel);
+
+        lock.lock();
+
+        if (!ready) {
+            // Cancelled, the memory goes back to the resident list and can be reused by the dataset being initialized.
+            m_next.seed = RxSeed();
+            m_entries.push_back(m_next);
+            m_next = Entry();
+
+            LOG_INFO("%s" YELLOW_BOLD("next dataset cancelled") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+            return;
+        }
+
+        m_next.ready = true;
+        lock.unlock();
+
+        LOG_INFO("%s" GREEN_BOLD("next dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+        write(dataset, seed, &cancel);
+    }
+
+
 private:
-    void printAllocStatus(uint64_t ts)
+    struct Entry
+    {
+        bool cacheReady     = false;
+        bool ready          = false;
+        bool unsaved        = false;
+        RxDataset *dataset  = nullptr;
+        RxSeed seed;
+    };
+
+
+    // The prepared slot is reserved as soon as it has a seed, even while its memory is still being allocated.
+    inline bool canAllocate(size_t extra = 0) const
+    {
+        const bool next = m_next.seed.algorithm().isValid();
+
+        if (m_entries.size() + (next ? 1 : 0) >= m_maxDatasets + extra) {
+            return false;
+        }
+
+        if (m_maxMemory == 0) {
+            return true;
+        }
+
+        size_t used = 0;
+        for (const auto &entry : m_entries) {
+            if (entry.dataset) {
+                used += entry.dataset->size();
+            }
+        }
+
+        if (next) {
+            used += m_next.dataset ? m_next.dataset->size() : RxDataset::maxSize() + RxCache::maxSize();
+        }
+
+        return used + RxDataset::maxSize() + RxCache::maxSize() <= m_maxMemory;
+    }
+
+
+    inline bool load(RxDataset *dataset, const RxSeed &seed) const
     {
-        if (m_dataset->get() != nullptr) {
-            const auto pages = m_dataset->hugePages();
+        if (m_filePath.isEmpty()) {
+            return false;
+        }
+
+        const uint64_t ts = Chrono::steadyMSecs();
+        if (!RxDatasetFile::load(dataset, seed, m_filePath)) {
+            return false;
+        }
+
+        LOG_INFO("%s" GREEN_BOLD("dataset loaded from file") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+        return true;
+    }
+
+
+    inline bool write(const RxDataset *dataset, const RxSeed &seed, const std::atomic<bool> *cancel) const
+    {
+        if (m_filePath.isEmpty()) {
+            return false;
+        }
+
+        const uint64_t ts = Chrono::steadyMSecs();
+        if (!RxDatasetFile::save(dataset, seed, m_filePath, m_maxFileSize, cancel)) {
+            return false;
+        }
+
+        LOG_INFO("%s" GREEN_BOLD("dataset saved to file") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+        return true;
+    }
+
+
+    inline void setReady(bool ready)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_entries.front().ready = ready;
+    }
+
+
+    static RxDataset *allocate(bool hugePages, bool oneGbPages, RxConfig::Mode mode)
+    {
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        auto dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0);
+        if (!dataset->cache()->get()) {
+            delete dataset;
+
+            LOG_INFO("%s" RED_BOLD("failed to allocate RandomX memory") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+            return nullptr;
+        }
+
+        printAllocStatus(dataset, ts);
+
+        return dataset;
+    }
+
+
+    static void printAllocStatus(const RxDataset *dataset, uint64_t ts)
+    {
+        if (dataset->get() != nullptr) {
+            const auto pages = dataset->hugePages();
 
             LOG_INFO("%s" GREEN_BOLD("allocated") CYAN_BOLD(" %zu MB") BLACK_BOLD(" (%zu+%zu)") " huge pages %s%1.0f%% %u/%u" CLEAR " %sJIT" BLACK_BOLD(" (%" PRIu64 " ms)"),
                      Tags::randomx(),
@@ -104,7 +456,7 @@ private:
                      pages.percent(),
                      pages.allocated,
                      pages.total,
-                     m_dataset->cache()->isJIT() ? GREEN_BOLD_S "+" : RED_BOLD_S "-",
+                     dataset->cache()->isJIT() ? GREEN_BOLD_S "+" : RED_BOLD_S "-",
                      Chrono::steadyMSecs() - ts
                      );
         }
@@ -114,17 +466,21 @@ private:
     }
 
 
-    bool m_ready         = false;
-    RxDataset *m_dataset = nullptr;
-    RxSeed m_seed;
+    const size_t m_maxDatasets;
+    const size_t m_maxFileSize;
+    const size_t m_maxMemory;
+    const String m_filePath;
+    Entry m_next;
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
 };
 
 
 } // namespace xmrig
 
 
-xmrig::RxBasicStorage::RxBasicStorage() :
-    d_ptr(new RxBasicStoragePrivate())
+xmrig::RxBasicStorage::RxBasicStorage(const RxConfig &config) :
+    d_ptr(new RxBasicStoragePrivate(config))
 {
 }
 
@@ -137,37 +493,49 @@ xmrig::RxBasicStorage::~RxBasicStorage()
 
 bool xmrig::RxBasicStorage::isAllocated() const
 {
-    return d_ptr->dataset() && d_ptr->dataset()->cache() && d_ptr->dataset()->cache()->get();
+    return d_ptr->isAllocated();
 }
 
 
 xmrig::HugePagesInfo xmrig::RxBasicStorage::hugePages() const
 {
-    if (!d_ptr->dataset()) {
-        return {};
-    }
-
-    return d_ptr->dataset()->hugePages();
+    return d_ptr->hugePages();
 }
 
 
 xmrig::RxDataset *xmrig::RxBasicStorage::dataset(const Job &job, uint32_t) const
 {
-    if (!d_ptr->isReady(job)) {
-        return nullptr;
-    }
+    return d_ptr->dataset(job);
+}
+
 
-    return d_ptr->dataset();
+xmrig::RxCache *xmrig::RxBasicStorage::cache(const Job &job, uint32_t) const
+{
+    return d_ptr->cache(job);
 }
 
 
 void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
 {
-    d_ptr->setSeed(seed);
+    if (!d_ptr->setSeed(seed)) {
+        return;
+    }
 
-    if (!d_ptr->dataset() && !d_ptr->createDataset(hugePages, oneGbPages, mode)) {
+    if (!d_ptr->hasDataset() && !d_ptr->createDataset(hugePages, oneGbPages, mode)) {
         return;
     }
 
     d_ptr->initDataset(threads, priority);
 }
+
+
+void xmrig::RxBasicStorage::save(const RxSeed &seed, const std::atomic<bool> &cancel)
+{
+    d_ptr->save(seed, cancel);
+}
+
+
+void xmrig::RxBasicStorage::prepare(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, const std::atomic<bool> &cancel)
+{
+    d_ptr->prepare(seed, threads, hugePages, oneGbPages, mode, cancel);
+}
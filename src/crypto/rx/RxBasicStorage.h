@@ -36,14 +36,17 @@ class RxBasicStorage : public IRxStorage
 public:
     XMRIG_DISABLE_COPY_MOVE(RxBasicStorage);
 
-    RxBasicStorage();
+    RxBasicStorage(const RxConfig &config);
     ~RxBasicStorage() override;
 
 protected:
     bool isAllocated() const override;
     HugePagesInfo hugePages() const override;
+    RxCache *cache(const Job &job, uint32_t nodeId) const override;
     RxDataset *dataset(const Job &job, uint32_t nodeId) const override;
     void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) override;
+    void save(const RxSeed &seed, const std::atomic<bool> &cancel) override;
+    void prepare(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, const std::atomic<bool> &cancel) override;
 
 private:
     RxBasicStoragePrivate *d_ptr;
@@ -73,12 +73,37 @@ bool xmrig::RxCache::init(const Buffer &seed)
 }
 
 
+bool xmrig::RxCache::restore(const Buffer &seed)
+{
+    if (!m_cache) {
+        return false;
+    }
+
+    m_seed = seed;
+    randomx_restore_cache(m_cache, m_seed.data(), m_seed.size());
+
+    return true;
+}
+
+
 xmrig::HugePagesInfo xmrig::RxCache::hugePages() const
 {
     return m_memory ? m_memory->hugePages() : HugePagesInfo();
 }
 
 
+size_t xmrig::RxCache::dataSize() const
+{
+    return m_cache ? randomx_cache_memory_size() : 0;
+}
+
+
+void *xmrig::RxCache::raw() const
+{
+    return m_cache ? randomx_get_cache_memory(m_cache) : nullptr;
+}
+
+
 void xmrig::RxCache::create(uint8_t *memory)
 {
     if (!memory) {
@@ -56,10 +56,14 @@ public:
     inline bool isJIT() const               { return m_jit; }
     inline const Buffer &seed() const       { return m_seed; }
     inline randomx_cache *get() const       { return m_cache; }
+    inline void reset()                     { m_seed = Buffer(); }
     inline size_t size() const              { return maxSize(); }
 
     bool init(const Buffer &seed);
+    bool restore(const Buffer &seed);
     HugePagesInfo hugePages() const;
+    size_t dataSize() const;
+    void *raw() const;
 
     static inline constexpr size_t maxSize() { return RANDOMX_CACHE_MAX_SIZE; }
 
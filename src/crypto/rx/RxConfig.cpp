@@ -36,13 +36,20 @@ namespace xmrig {
 
 const char *RxConfig::kInit                     = "init";
 const char *RxConfig::kInitAVX2                 = "init-avx2";
+const char *RxConfig::kLightFallbackThreads      = "light_fallback_threads";
 const char *RxConfig::kField                    = "randomx";
+const char *RxConfig::kMaxDatasets              = "max_datasets";
+const char *RxConfig::kMaxDatasetsMemory        = "max_datasets_memory";
 const char *RxConfig::kMode                     = "mode";
 const char *RxConfig::kOneGbPages               = "1gb-pages";
 const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kDatasetFileMaxSize       = "dataset_file_max_size";
+const char *RxConfig::kDatasetFilePath          = "dataset_file_path";
+const char *RxConfig::kPrepareNextDataset       = "prepare_next_dataset";
+const char *RxConfig::kPrepareNextDatasetThreads = "prepare_next_dataset_threads";
 
 #ifdef XMRIG_FEATURE_HWLOC
 const char *RxConfig::kNUMA                     = "numa";
@@ -88,6 +95,13 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
 #       endif
 
         m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
+        m_maxDatasets = std::max(Json::getUint(value, kMaxDatasets, m_maxDatasets), 1U);
+        m_maxDatasetsMemory = Json::getUint64(value, kMaxDatasetsMemory, m_maxDatasetsMemory);
+        m_prepareNextDataset = Json::getBool(value, kPrepareNextDataset, m_prepareNextDataset);
+        m_prepareNextDatasetThreads = std::max(Json::getUint(value, kPrepareNextDatasetThreads, m_prepareNextDatasetThreads), 1U);
+        m_datasetFilePath = Json::getString(value, kDatasetFilePath);
+        m_datasetFileMaxSize = Json::getUint64(value, kDatasetFileMaxSize, m_datasetFileMaxSize);
+        m_lightFallbackThreads = Json::getUint(value, kLightFallbackThreads, m_lightFallbackThreads);
 
 #       ifdef XMRIG_OS_LINUX
         m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
@@ -158,6 +172,13 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
     obj.AddMember(StringRef(kCacheQoS), m_cacheQoS, allocator);
+    obj.AddMember(StringRef(kMaxDatasets), m_maxDatasets, allocator);
+    obj.AddMember(StringRef(kMaxDatasetsMemory), static_cast<uint64_t>(m_maxDatasetsMemory), allocator);
+    obj.AddMember(StringRef(kPrepareNextDataset), m_prepareNextDataset, allocator);
+    obj.AddMember(StringRef(kPrepareNextDatasetThreads), m_prepareNextDatasetThreads, allocator);
+    obj.AddMember(StringRef(kDatasetFilePath), m_datasetFilePath.toJSON(), allocator);
+    obj.AddMember(StringRef(kDatasetFileMaxSize), static_cast<uint64_t>(m_datasetFileMaxSize), allocator);
+    obj.AddMember(StringRef(kLightFallbackThreads), m_lightFallbackThreads, allocator);
 
 #   ifdef XMRIG_FEATURE_HWLOC
     if (!m_nodeset.empty()) {
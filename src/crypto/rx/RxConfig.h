@@ -21,6 +21,7 @@
 
 
 #include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -53,11 +54,18 @@ public:
     };
 
     static const char *kCacheQoS;
+    static const char *kDatasetFileMaxSize;
+    static const char *kDatasetFilePath;
     static const char *kField;
     static const char *kInit;
     static const char *kInitAVX2;
+    static const char *kLightFallbackThreads;
+    static const char *kMaxDatasets;
+    static const char *kMaxDatasetsMemory;
     static const char *kMode;
     static const char *kOneGbPages;
+    static const char *kPrepareNextDataset;
+    static const char *kPrepareNextDatasetThreads;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
     static const char *kWrmsr;
@@ -83,6 +91,13 @@ public:
     inline bool rdmsr() const           { return m_rdmsr; }
     inline bool wrmsr() const           { return m_wrmsr; }
     inline bool cacheQoS() const        { return m_cacheQoS; }
+    inline bool isPrepareNextDataset() const { return m_prepareNextDataset; }
+    inline const String &datasetFilePath() const { return m_datasetFilePath; }
+    inline size_t datasetFileMaxSize() const { return m_datasetFileMaxSize; }
+    inline uint32_t lightFallbackThreads() const { return m_lightFallbackThreads; }
+    inline uint32_t maxDatasets() const { return m_maxDatasets; }
+    inline uint32_t prepareNextDatasetThreads() const { return m_prepareNextDatasetThreads; }
+    inline size_t maxDatasetsMemory() const { return m_maxDatasetsMemory; }
     inline Mode mode() const            { return m_mode; }
 
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
@@ -108,9 +123,16 @@ private:
     static Mode readMode(const rapidjson::Value &value);
 
     bool m_oneGbPages     = false;
+    bool m_prepareNextDataset = false;
     bool m_rdmsr          = true;
     int m_threads         = -1;
     int m_initDatasetAVX2 = -1;
+    size_t m_datasetFileMaxSize = 0;
+    size_t m_maxDatasetsMemory = 0;
+    String m_datasetFilePath;
+    uint32_t m_lightFallbackThreads = 0;
+    uint32_t m_maxDatasets = 1;
+    uint32_t m_prepareNextDatasetThreads = 1;
     Mode m_mode           = AutoMode;
 
     ScratchpadPrefetchMode m_scratchpadPrefetchMode = ScratchpadPrefetchT0;
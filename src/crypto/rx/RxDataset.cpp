@@ -28,6 +28,7 @@
 #include "crypto/rx/RxCache.h"
 
 
+#include <algorithm>
 #include <thread>
 #include <uv.h>
 
@@ -35,10 +36,8 @@
 namespace xmrig {
 
 
-static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, int priority)
+static void init_dataset_range(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount)
 {
-    Platform::setThreadPriority(priority);
-
     if (Cpu::info()->hasAVX2() && (itemCount % 5)) {
         randomx_init_dataset(dataset, cache, startItem, itemCount - (itemCount % 5));
         randomx_init_dataset(dataset, cache, startItem + itemCount - 5, 5);
@@ -55,6 +54,23 @@ static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache,
 }
 
 
+static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, int priority, const std::atomic<bool> *cancel)
+{
+    Platform::setThreadPriority(priority);
+
+    if (!cancel) {
+        return init_dataset_range(dataset, cache, startItem, itemCount);
+    }
+
+    // Cancellable builds run in small chunks so a cancel request is noticed within milliseconds.
+    constexpr uint32_t chunkSize = 20480;
+
+    for (uint32_t i = 0; i < itemCount && !cancel->load(std::memory_order_relaxed); i += chunkSize) {
+        init_dataset_range(dataset, cache, startItem + i, std::min(chunkSize, itemCount - i));
+    }
+}
+
+
 } // namespace xmrig
 
 
@@ -92,7 +108,7 @@ xmrig::RxDataset::~RxDataset()
 }
 
 
-bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priority)
+bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priority, const std::atomic<bool> *cancel)
 {
     if (!m_cache || !m_cache->get()) {
         return false;
@@ -101,7 +117,7 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
     m_cache->init(seed);
 
     if (!get()) {
-        return true;
+        return !cancel || !cancel->load();
     }
 
     const uint64_t datasetItemCount = randomx_dataset_item_count();
@@ -113,7 +129,7 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
         for (uint64_t i = 0; i < numThreads; ++i) {
             const uint32_t a = (datasetItemCount * i) / numThreads;
             const uint32_t b = (datasetItemCount * (i + 1)) / numThreads;
-            threads.emplace_back(init_dataset_wrapper, m_dataset, m_cache->get(), a, b - a, priority);
+            threads.emplace_back(init_dataset_wrapper, m_dataset, m_cache->get(), a, b - a, priority, cancel);
         }
 
         for (uint32_t i = 0; i < numThreads; ++i) {
@@ -121,10 +137,10 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
         }
     }
     else {
-        init_dataset_wrapper(m_dataset, m_cache->get(), 0, datasetItemCount, priority);
+        init_dataset_wrapper(m_dataset, m_cache->get(), 0, datasetItemCount, priority, cancel);
     }
 
-    return true;
+    return !cancel || !cancel->load();
 }
 
 
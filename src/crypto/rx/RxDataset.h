@@ -54,7 +54,7 @@ public:
     inline RxCache *cache() const           { return m_cache; }
     inline void setCache(RxCache *cache)    { m_cache = cache; }
 
-    bool init(const Buffer &seed, uint32_t numThreads, int priority);
+    bool init(const Buffer &seed, uint32_t numThreads, int priority, const std::atomic<bool> *cancel = nullptr);
     bool isHugePages() const;
     bool isOneGbPages() const;
     HugePagesInfo hugePages(bool cache = true) const;
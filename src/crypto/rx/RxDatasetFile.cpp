@@ -0,0 +1,261 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxDatasetFile.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/String.h"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+
+namespace xmrig {
+
+
+static constexpr uint64_t kMagic    = 0x3130534458524d58ULL; // "XMRXDS01"
+static constexpr uint32_t kVersion  = 1;
+static constexpr size_t kChunkSize  = 64 * 1024 * 1024;
+
+
+struct RxDatasetFileHeader
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t algorithm;
+    uint8_t seed[32];
+    uint64_t cacheSize;
+    uint64_t datasetSize;
+    uint64_t checksum;
+};
+
+
+// Four independent multiply-xor lanes, fast enough to verify gigabytes at memory speed.
+class RxChecksum
+{
+public:
+    inline void update(const uint8_t *data, size_t size)
+    {
+        uint64_t v[4];
+
+        for (size_t i = 0; i + sizeof(v) <= size; i += sizeof(v)) {
+            memcpy(v, data + i, sizeof(v));
+
+            for (size_t k = 0; k < 4; ++k) {
+                m_state[k] = (m_state[k] ^ v[k]) * 0x9E3779B97F4A7C15ULL;
+                m_state[k] ^= m_state[k] >> 29;
+            }
+        }
+    }
+
+    inline uint64_t value() const { return m_state[0] ^ (m_state[1] * 3) ^ (m_state[2] * 5) ^ (m_state[3] * 7); }
+
+private:
+    uint64_t m_state[4] = { 1, 2, 3, 4 };
+};
+
+
+static String fileName(const String &path, const Algorithm &algorithm)
+{
+    std::string name = algorithm.name();
+    std::replace(name.begin(), name.end(), '/', '_');
+
+    return (std::string(path) + "/" + name + ".rxds").c_str();
+}
+
+
+static size_t datasetSize(const RxDataset *dataset)
+{
+    return dataset->get() ? randomx_dataset_item_count() * RANDOMX_DATASET_ITEM_SIZE : 0;
+}
+
+
+static bool read(std::ifstream &ifs, void *data, size_t size, RxChecksum &checksum)
+{
+    auto p = static_cast<uint8_t *>(data);
+
+    for (size_t offset = 0; offset < size; offset += kChunkSize) {
+        const size_t n = std::min(kChunkSize, size - offset);
+        if (!ifs.read(reinterpret_cast<char *>(p + offset), static_cast<std::streamsize>(n))) {
+            return false;
+        }
+
+        checksum.update(p + offset, n);
+    }
+
+    return true;
+}
+
+
+static bool write(std::ofstream &ofs, const void *data, size_t size, RxChecksum &checksum, const std::atomic<bool> *cancel)
+{
+    auto p = static_cast<const uint8_t *>(data);
+
+    for (size_t offset = 0; offset < size; offset += kChunkSize) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        const size_t n = std::min(kChunkSize, size - offset);
+        checksum.update(p + offset, n);
+
+        if (!ofs.write(reinterpret_cast<const char *>(p + offset), static_cast<std::streamsize>(n))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static uint64_t fileSize(const String &name)
+{
+    std::ifstream ifs(name, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+
+    return ifs.is_open() ? static_cast<uint64_t>(ifs.tellg()) : 0;
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxDatasetFile::load(RxDataset *dataset, const RxSeed &seed, const String &path)
+{
+    auto cache = dataset->cache();
+    if (path.isEmpty() || !cache || !cache->get() || seed.data().size() != sizeof(RxDatasetFileHeader::seed)) {
+        return false;
+    }
+
+    std::ifstream ifs(fileName(path, seed.algorithm()), std::ios_base::in | std::ios_base::binary);
+    if (!ifs.is_open()) {
+        return false;
+    }
+
+    RxDatasetFileHeader header{};
+    if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+        return false;
+    }
+
+    if (header.magic != kMagic ||
+        header.version != kVersion ||
+        header.algorithm != seed.algorithm().id() ||
+        memcmp(header.seed, seed.data().data(), sizeof(header.seed)) != 0 ||
+        header.cacheSize != cache->dataSize() ||
+        header.datasetSize != datasetSize(dataset)
+        ) {
+        return false;
+    }
+
+    RxChecksum checksum;
+    const bool ok = read(ifs, cache->raw(), header.cacheSize, checksum) &&
+                    read(ifs, dataset->raw(), header.datasetSize, checksum) &&
+                    checksum.value() == header.checksum;
+
+    if (!ok) {
+        cache->reset();
+
+        LOG_WARN("%s" YELLOW_BOLD("dataset file is corrupted, ignoring it"), Tags::randomx());
+
+        return false;
+    }
+
+    return cache->restore(seed.data());
+}
+
+
+bool xmrig::RxDatasetFile::save(const RxDataset *dataset, const RxSeed &seed, const String &path, size_t maxSize, const std::atomic<bool> *cancel)
+{
+    const auto cache = dataset->cache();
+    if (path.isEmpty() || !cache || !cache->get() || seed.data().size() != sizeof(RxDatasetFileHeader::seed)) {
+        return false;
+    }
+
+    RxDatasetFileHeader header{};
+    header.magic        = kMagic;
+    header.version      = kVersion;
+    header.algorithm    = seed.algorithm().id();
+    header.cacheSize    = cache->dataSize();
+    header.datasetSize  = datasetSize(dataset);
+
+    memcpy(header.seed, seed.data().data(), sizeof(header.seed));
+
+    const String name = fileName(path, seed.algorithm());
+
+    if (maxSize) {
+        uint64_t used = sizeof(header) + header.cacheSize + header.datasetSize;
+
+        for (const auto &algorithm : Algorithm::all([&seed](const Algorithm &algo) { return algo.family() == Algorithm::RANDOM_X && algo != seed.algorithm(); })) {
+            used += fileSize(fileName(path, algorithm));
+        }
+
+        if (used > maxSize) {
+            LOG_WARN("%s" YELLOW_BOLD("dataset file skipped, it would exceed the disk limit"), Tags::randomx());
+
+            return false;
+        }
+    }
+
+    const String tmp = (std::string(name) + ".tmp").c_str();
+
+    {
+        std::ofstream ofs(tmp, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!ofs.is_open()) {
+            LOG_WARN("%s" YELLOW_BOLD("failed to create dataset file \"%s\""), Tags::randomx(), tmp.data());
+
+            return false;
+        }
+
+        RxChecksum checksum;
+        bool ok = ofs.write(reinterpret_cast<const char *>(&header), sizeof(header)) &&
+                  write(ofs, cache->raw(), header.cacheSize, checksum, cancel) &&
+                  write(ofs, dataset->raw(), header.datasetSize, checksum, cancel);
+
+        if (ok) {
+            header.checksum = checksum.value();
+            ok = ofs.seekp(0) && ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        }
+
+        ofs.close();
+
+        // The dataset may be reused for another seed as soon as the save is cancelled, a partial file is never kept.
+        if (cancel && cancel->load()) {
+            std::remove(tmp);
+
+            return false;
+        }
+
+        if (!ok || ofs.fail()) {
+            std::remove(tmp);
+
+            LOG_WARN("%s" YELLOW_BOLD("failed to write dataset file \"%s\""), Tags::randomx(), tmp.data());
+
+            return false;
+        }
+    }
+
+    std::remove(name);
+
+    return std::rename(tmp, name) == 0;
+}
@@ -0,0 +1,48 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_DATASETFILE_H
+#define XMRIG_RX_DATASETFILE_H
+
+
+#include <atomic>
+#include <cstddef>
+
+
+namespace xmrig
+{
+
+
+class RxDataset;
+class RxSeed;
+class String;
+
+
+// On-disk copy of an initialized RandomX cache and dataset, one file per algorithm.
+class RxDatasetFile
+{
+public:
+    static bool load(RxDataset *dataset, const RxSeed &seed, const String &path);
+    static bool save(const RxDataset *dataset, const RxSeed &seed, const String &path, size_t maxSize, const std::atomic<bool> *cancel = nullptr);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_DATASETFILE_H */
@@ -45,9 +45,13 @@ public:
 protected:
     bool isAllocated() const override;
     HugePagesInfo hugePages() const override;
+    inline RxCache *cache(const Job &, uint32_t) const override { return nullptr; }
     RxDataset *dataset(const Job &job, uint32_t nodeId) const override;
     void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) override;
 
+    inline void save(const RxSeed &, const std::atomic<bool> &) override {}
+    inline void prepare(const RxSeed &, uint32_t, bool, bool, RxConfig::Mode, const std::atomic<bool> &) override {}
+
 private:
     RxNUMAStoragePrivate *d_ptr;
 };
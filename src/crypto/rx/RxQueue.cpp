@@ -23,6 +23,7 @@
 #include "base/io/Async.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "crypto/rx/RxBasicStorage.h"
 
@@ -35,8 +36,9 @@
 xmrig::RxQueue::RxQueue(IRxListener *listener) :
     m_listener(listener)
 {
-    m_async  = std::make_shared<Async>(this);
-    m_thread = std::thread(&RxQueue::backgroundInit, this);
+    m_async         = std::make_shared<Async>(this);
+    m_thread        = std::thread(&RxQueue::backgroundInit, this);
+    m_prepareThread = std::thread(&RxQueue::backgroundPrepare, this);
 }
 
 
@@ -44,16 +46,31 @@ xmrig::RxQueue::~RxQueue()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
     m_state = STATE_SHUTDOWN;
+    m_cancelPrepare = true;
     lock.unlock();
 
     m_cv.notify_one();
+    m_prepareCv.notify_one();
 
     m_thread.join();
+    m_prepareThread.join();
 
     delete m_storage;
 }
 
 
+xmrig::RxCache *xmrig::RxQueue::cache(const Job &job, uint32_t nodeId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_storage && m_seed == job) {
+        return m_storage->cache(job, nodeId);
+    }
+
+    return nullptr;
+}
+
+
 xmrig::RxDataset *xmrig::RxQueue::dataset(const Job &job, uint32_t nodeId)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -83,7 +100,7 @@ bool xmrig::RxQueue::isReady(const T &seed)
 }
 
 
-void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const RxConfig &config)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
 
@@ -95,7 +112,7 @@ void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &no
         else
 #       endif
         {
-            m_storage = new RxBasicStorage();
+            m_storage = new RxBasicStorage(config);
         }
     }
 
@@ -106,6 +123,8 @@ void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &no
     m_queue.emplace_back(seed, nodeset, threads, hugePages, oneGbPages, mode, priority);
     m_seed  = seed;
     m_state = STATE_PENDING;
+    m_nextSeed = RxSeed();
+    m_cancelPrepare = true;
 
     lock.unlock();
 
@@ -113,10 +132,28 @@ void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &no
 }
 
 
+void xmrig::RxQueue::prepare(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (!m_storage || m_nextSeed == seed || m_seed == seed) {
+        return;
+    }
+
+    m_next.clear();
+    m_next.emplace_back(seed, std::vector<uint32_t>(), threads, hugePages, oneGbPages, mode, 0);
+    m_nextSeed = seed;
+
+    lock.unlock();
+
+    m_prepareCv.notify_one();
+}
+
+
 template<typename T>
 bool xmrig::RxQueue::isReadyUnsafe(const T &seed) const
 {
-    return m_storage != nullptr && m_storage->isAllocated() && m_state == STATE_IDLE && m_seed == seed;
+    return m_storage != nullptr && m_state == STATE_IDLE && m_storage->isAllocated() && m_seed == seed;
 }
 
 
@@ -146,8 +183,19 @@ void xmrig::RxQueue::backgroundInit()
                  Cvt::toHex(item.seed.data().data(), 8).data()
                  );
 
+        const uint64_t ts = Chrono::steadyMSecs();
+        m_lightHashes     = 0;
+
         m_storage->init(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority);
 
+        const uint64_t lightHashes = m_lightHashes.exchange(0);
+        if (lightHashes) {
+            const uint64_t elapsed = std::max<uint64_t>(Chrono::steadyMSecs() - ts, 1);
+
+            LOG_INFO("%s" WHITE_BOLD("light mode fallback") " %" PRIu64 " hashes, " CYAN_BOLD("%.1f") " H/s" BLACK_BOLD(" (%" PRIu64 " ms)"),
+                     Tags::randomx(), lightHashes, static_cast<double>(lightHashes) * 1000.0 / elapsed, elapsed);
+        }
+
         lock.lock();
 
         if (m_state == STATE_SHUTDOWN || !m_queue.empty()) {
@@ -156,8 +204,57 @@ void xmrig::RxQueue::backgroundInit()
 
         // Update seed here again in case there was more than one item in the queue
         m_seed = item.seed;
+        m_saveSeed = item.seed;
         m_state = STATE_IDLE;
         m_async->send();
+        m_prepareCv.notify_one();
+    }
+}
+
+
+// Writes the dataset file and builds the next seed's dataset only while the queue is idle,
+// a new enqueue() or shutdown cancels both, so the queue thread never waits for them.
+void xmrig::RxQueue::backgroundPrepare()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_prepareCv.wait(lock, [this]{ return m_state == STATE_SHUTDOWN || (m_state == STATE_IDLE && (m_saveSeed.algorithm().isValid() || !m_next.empty())); });
+
+        if (m_state == STATE_SHUTDOWN) {
+            return;
+        }
+
+        m_cancelPrepare = false;
+
+        if (m_saveSeed.algorithm().isValid()) {
+            const auto seed = m_saveSeed;
+            m_saveSeed = RxSeed();
+
+            lock.unlock();
+
+            m_storage->save(seed, m_cancelPrepare);
+
+            lock.lock();
+
+            continue;
+        }
+
+        const auto item = m_next.back();
+        m_next.clear();
+
+        lock.unlock();
+
+        LOG_INFO("%s" MAGENTA_BOLD("prepare next dataset") " algo " WHITE_BOLD("%s (") CYAN_BOLD("%u") WHITE_BOLD(" threads)") BLACK_BOLD(" seed %s..."),
+                 Tags::randomx(),
+                 item.seed.algorithm().name(),
+                 item.threads,
+                 Cvt::toHex(item.seed.data().data(), 8).data()
+                 );
+
+        m_storage->prepare(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, m_cancelPrepare);
+
+        lock.lock();
     }
 }
 
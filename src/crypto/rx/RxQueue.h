@@ -29,6 +29,7 @@
 #include "crypto/rx/RxSeed.h"
 
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -40,6 +41,7 @@ namespace xmrig
 
 class IRxListener;
 class IRxStorage;
+class RxCache;
 class RxDataset;
 
 
@@ -75,9 +77,13 @@ public:
     ~RxQueue() override;
 
     HugePagesInfo hugePages();
+    RxCache *cache(const Job &job, uint32_t nodeId);
     RxDataset *dataset(const Job &job, uint32_t nodeId);
     template<typename T> bool isReady(const T &seed);
-    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
+    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority, const RxConfig &config);
+    void prepare(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode);
+
+    inline void addLightHashes(uint64_t count)  { m_lightHashes.fetch_add(count, std::memory_order_relaxed); }
 
 protected:
     inline void onAsync() override  { onReady(); }
@@ -91,16 +97,24 @@ private:
 
     template<typename T> bool isReadyUnsafe(const T &seed) const;
     void backgroundInit();
+    void backgroundPrepare();
     void onReady();
 
     IRxListener *m_listener = nullptr;
     IRxStorage *m_storage   = nullptr;
+    RxSeed m_nextSeed;
+    RxSeed m_saveSeed;
     RxSeed m_seed;
     State m_state = STATE_IDLE;
+    std::atomic<bool> m_cancelPrepare{ false };
+    std::atomic<uint64_t> m_lightHashes{ 0 };
     std::condition_variable m_cv;
+    std::condition_variable m_prepareCv;
     std::mutex m_mutex;
     std::shared_ptr<Async> m_async;
+    std::thread m_prepareThread;
     std::thread m_thread;
+    std::vector<RxQueueItem> m_next;
     std::vector<RxQueueItem> m_queue;
 };
 
@@ -25,7 +25,10 @@
 #include "crypto/rx/RxVm.h"
 
 
-randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
+namespace xmrig {
+
+
+static randomx_vm *createVm(RxCache *cache, randomx_dataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
 {
     int flags = 0;
 
@@ -41,11 +44,11 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
     (void)softAes; // unused on RISC-V to force soft AES
 #   endif
 
-    if (dataset->get()) {
+    if (dataset) {
         flags |= RANDOMX_FLAG_FULL_MEM;
     }
 
-    if (!dataset->cache() || dataset->cache()->isJIT()) {
+    if (!cache || cache->isJIT()) {
         flags |= RANDOMX_FLAG_JIT;
     }
 
@@ -54,7 +57,22 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
         flags |= RANDOMX_FLAG_AMD;
     }
 
-    return randomx_create_vm(static_cast<randomx_flags>(flags), !dataset->get() ? dataset->cache()->get() : nullptr, dataset->get(), scratchpad, node);
+    return randomx_create_vm(static_cast<randomx_flags>(flags), !dataset ? cache->get() : nullptr, dataset, scratchpad, node);
+}
+
+
+} // namespace xmrig
+
+
+randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
+{
+    return createVm(dataset->cache(), dataset->get(), scratchpad, softAes, assembly, node);
+}
+
+
+randomx_vm *xmrig::RxVm::create(RxCache *cache, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
+{
+    return createVm(cache, nullptr, scratchpad, softAes, assembly, node);
 }
 
 
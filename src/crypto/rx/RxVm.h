@@ -32,12 +32,14 @@ namespace xmrig
 
 
 class Assembly;
+class RxCache;
 class RxDataset;
 
 
 class RxVm
 {
 public:
+    static randomx_vm *create(RxCache *cache, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node);
     static randomx_vm *create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node);
     static void destroy(randomx_vm *vm);
 };
@@ -0,0 +1,69 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxYespower.h"
+#include "backend/cpu/Cpu.h"
+#include "base/tools/String.h"
+
+
+extern "C" {
+#include "crypto/randomx/panthera/yespower.h"
+}
+
+
+namespace xmrig {
+
+
+static bool selected = false;
+static String implName;
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxYespower::select()
+{
+    if (selected) {
+        return false;
+    }
+
+#   if defined(__x86_64__) || defined(_M_AMD64)
+    const ICpuInfo *info = Cpu::info();
+
+    if (info->has(ICpuInfo::FLAG_AVX512VL)) {
+        yespower_select_impl_by_name("AVX-512VL");
+    }
+    else if (info->has(ICpuInfo::FLAG_AVX2)) {
+        yespower_select_impl_by_name("AVX2");
+    }
+    else if (info->has(ICpuInfo::FLAG_AVX)) {
+        yespower_select_impl_by_name("AVX");
+    }
+#   endif
+
+    selected = true;
+    implName = yespower_get_impl_name();
+
+    return true;
+}
+
+
+const xmrig::String &xmrig::RxYespower::name()
+{
+    return implName;
+}
@@ -24,6 +24,7 @@
 
 
 #include "net/JobResults.h"
+#include "3rdparty/rapidjson/document.h"
 #include "backend/common/Tags.h"
 #include "base/io/Async.h"
 #include "base/io/log/Log.h"
@@ -55,16 +56,153 @@
 #endif
 
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <uv.h>
+#include <vector>
 
 
 namespace xmrig {
 
 
+// Single producer, single consumer queue of fixed size result records, one per submitting thread.
+//
+// The producer copies the job only when it differs from the previous one, so a record is a nonce, a hash and
+// a shared pointer. The main loop is the only consumer.
+class ResultRing
+{
+public:
+    static constexpr size_t kSize = 256;
+
+    struct Record
+    {
+        std::shared_ptr<const Job> job;
+        uint64_t ts         = 0;
+        uint32_t nonce      = 0;
+        bool done           = false;
+        bool hasSignature   = false;
+        uint8_t result[32];
+        uint8_t signature[64];
+    };
+
+    inline bool push(const Job &job, uint32_t nonce, const uint8_t *result, const uint8_t *signature)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= kSize) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+
+            return false;
+        }
+
+        if (!m_job || !isSame(*m_job, job)) {
+            m_job = std::make_shared<const Job>(job);
+        }
+
+        Record &record      = m_records[head % kSize];
+        record.job          = m_job;
+        record.ts           = uv_hrtime();
+        record.nonce        = nonce;
+        record.done         = result == nullptr;
+        record.hasSignature = signature != nullptr;
+
+        if (result) {
+            memcpy(record.result, result, sizeof(record.result));
+        }
+
+        if (signature) {
+            memcpy(record.signature, signature, sizeof(record.signature));
+        }
+
+        m_head.store(head + 1, std::memory_order_release);
+        queued.fetch_add(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    template<typename T>
+    inline void drain(T callback)
+    {
+        const size_t head = m_head.load(std::memory_order_acquire);
+
+        for (size_t i = m_tail.load(std::memory_order_relaxed); i != head; ++i) {
+            Record &record = m_records[i % kSize];
+            callback(record);
+            record.job.reset();
+        }
+
+        m_tail.store(head, std::memory_order_release);
+    }
+
+    std::atomic<bool> owned{ false };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::atomic<uint64_t> queued{ 0 };
+
+private:
+    static inline bool isSame(const Job &a, const Job &b)
+    {
+        return a.index() == b.index() && a.backend() == b.backend() && a.diff() == b.diff() && a.algorithm() == b.algorithm() && a.id() == b.id() && a.clientId() == b.clientId();
+    }
+
+    Record m_records[kSize];
+    std::atomic<size_t> m_head{ 0 };
+    std::atomic<size_t> m_tail{ 0 };
+    std::shared_ptr<const Job> m_job;   // producer side only
+};
+
+
+// Rings are never freed before exit, a ring released by a finished thread is reused by the next new thread.
+static std::mutex ringsMutex;
+static std::vector<std::unique_ptr<ResultRing>> rings;
+static std::atomic<bool> ringsPending{ false };
+static uint64_t latencySum      = 0;
+static uint64_t latencyMax      = 0;
+static uint64_t latencyCount    = 0;
+
+
+class ResultRingOwner
+{
+public:
+    inline ~ResultRingOwner()
+    {
+        if (ring) {
+            ring->owned.store(false);
+        }
+    }
+
+    inline ResultRing *get()
+    {
+        if (!ring) {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+
+            for (auto &r : rings) {
+                bool expected = false;
+                if (r->owned.compare_exchange_strong(expected, true)) {
+                    ring = r.get();
+
+                    return ring;
+                }
+            }
+
+            rings.emplace_back(new ResultRing());
+            ring = rings.back().get();
+            ring->owned.store(true);
+        }
+
+        return ring;
+    }
+
+private:
+    ResultRing *ring = nullptr;
+};
+
+
+static thread_local ResultRingOwner ringOwner;
+
+
 #if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
 class JobBundle
 {
@@ -146,6 +284,15 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
     }
     else if (algorithm.family() == Algorithm::KAWPOW) {
 #       ifdef XMRIG_ALGO_KAWPOW
+        // One lookup for the whole bundle, hashing itself runs without any lock
+        const KPCache::Ptr cache = KPCache::get(bundle.job.height() / KPHash::EPOCH_LENGTH);
+        if (!cache) {
+            errors += bundle.nonces.size();
+            delete memory;
+
+            return;
+        }
+
         for (uint32_t nonce : bundle.nonces) {
             *bundle.job.nonce() = nonce;
 
@@ -156,12 +303,7 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
             uint32_t output[8];
             uint32_t mix_hash[8];
-            {
-                std::lock_guard<std::mutex> lock(KPCache::s_cacheMutex);
-
-                KPCache::s_cache.init(bundle.job.height() / KPHash::EPOCH_LENGTH);
-                KPHash::calculate(KPCache::s_cache, bundle.job.height(), header_hash, full_nonce, output, mix_hash);
-            }
+            KPHash::calculate(*cache, bundle.job.height(), header_hash, full_nonce, output, mix_hash);
 
             for (size_t i = 0; i < sizeof(hash); ++i) {
                 hash[i] = ((uint8_t*)output)[sizeof(hash) - 1 - i];
@@ -220,6 +362,14 @@ public:
     }
 
 
+    inline void submit(const Job &job, uint32_t nonce, const uint8_t *result, const uint8_t *signature)
+    {
+        if (ringOwner.get()->push(job, nonce, result, signature) && !ringsPending.exchange(true)) {
+            m_async->send();
+        }
+    }
+
+
 #   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
     inline void submit(const Job &job, uint32_t *results, size_t count, uint32_t device_index)
     {
@@ -232,10 +382,47 @@ public:
 
 
 protected:
-    inline void onAsync() override  { submit(); }
+    inline void onAsync() override
+    {
+        drain();
+        submit();
+    }
 
 
 private:
+    void drain()
+    {
+        ringsPending.store(false);
+
+        std::vector<ResultRing *> list;
+        {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            list.reserve(rings.size());
+
+            for (auto &ring : rings) {
+                list.emplace_back(ring.get());
+            }
+        }
+
+        const uint64_t now = uv_hrtime();
+
+        for (ResultRing *ring : list) {
+            ring->drain([this, now](const ResultRing::Record &record) {
+                const uint64_t latency = now > record.ts ? now - record.ts : 0;
+                latencySum += latency;
+                latencyMax  = std::max(latencyMax, latency);
+                ++latencyCount;
+
+                if (record.done) {
+                    m_listener->onJobResult(JobResult(*record.job));
+                }
+                else {
+                    m_listener->onJobResult(JobResult(*record.job, record.nonce, record.result, nullptr, nullptr, record.hasSignature ? record.signature : nullptr));
+                }
+            });
+        }
+    }
+
 #   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
     inline void submit()
     {
@@ -309,9 +496,37 @@ static JobResultsPrivate *handler = nullptr;
 } // namespace xmrig
 
 
+rapidjson::Value xmrig::JobResults::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    uint64_t queued  = 0;
+    uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+
+        for (const auto &ring : rings) {
+            queued  += ring->queued.load(std::memory_order_relaxed);
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+    }
+
+    Value out(kObjectType);
+    out.AddMember("queued",         queued, allocator);
+    out.AddMember("dropped",        dropped, allocator);
+    out.AddMember("latency_avg_us", latencyCount ? (latencySum / latencyCount / 1000) : 0, allocator);
+    out.AddMember("latency_max_us", latencyMax / 1000, allocator);
+
+    return out;
+}
+
+
 void xmrig::JobResults::done(const Job &job)
 {
-    submit(JobResult(job));
+    if (handler) {
+        handler->submit(job, 0, nullptr, nullptr);
+    }
 }
 
 
@@ -335,13 +550,17 @@ void xmrig::JobResults::stop()
 
 void xmrig::JobResults::submit(const Job &job, uint32_t nonce, const uint8_t *result)
 {
-    submit(JobResult(job, nonce, result));
+    submit(job, nonce, result, nullptr);
 }
 
 
 void xmrig::JobResults::submit(const Job& job, uint32_t nonce, const uint8_t* result, const uint8_t* miner_signature)
 {
-    submit(JobResult(job, nonce, result, nullptr, nullptr, miner_signature));
+    assert(handler != nullptr && result != nullptr);
+
+    if (handler) {
+        handler->submit(job, nonce, result, miner_signature);
+    }
 }
 
 
@@ -27,6 +27,9 @@
 #define XMRIG_JOBRESULTS_H
 
 
+#include "3rdparty/rapidjson/fwd.h"
+
+
 #include <cstddef>
 #include <cstdint>
 
@@ -39,9 +42,12 @@ class Job;
 class JobResult;
 
 
+// Single nonce results and "done" notifications are passed through a lock-free ring of the submitting thread,
+// the main loop drains all rings on a single coalesced wake-up.
 class JobResults
 {
 public:
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
     static void done(const Job &job);
     static void setListener(IJobResultListener *listener, bool hwAES);
     static void stop();
@@ -346,6 +346,9 @@ void xmrig::Network::getResults(rapidjson::Value &reply, rapidjson::Document &do
     using namespace rapidjson;
     auto &allocator = doc.GetAllocator();
 
-    reply.AddMember("results", m_state->getResults(doc, version), allocator);
+    Value results = m_state->getResults(doc, version);
+    results.AddMember("queue", JobResults::toJSON(doc), allocator);
+
+    reply.AddMember("results", results, allocator);
 }
 #endif